@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <cstdlib>
+# include <unordered_set>
 #endif
 
 #include <cctype>
@@ -226,6 +227,137 @@ struct CStringComp
     }
 };
 
+// Lookup table from mapped names to indexed names with less memory overhead
+// than a std::map. Most names are kept in a flat vector sorted by name. New
+// names are inserted into a small std::map first, which is merged into the
+// vector once it grows beyond a fraction of the vector size. Erased names in
+// the vector are marked with a null indexed name until the next merge.
+class MappedNameIndex
+{
+public:
+    using value_type = std::pair<const MappedName, IndexedName>;
+
+    /// Insert a new name, or return the existing entry of the same name
+    std::pair<const value_type *, bool> insert(const MappedName &name, const IndexedName &idx)
+    {
+        auto it = lowerBound(name);
+        if (it != sorted.end() && it->first.compare(name) == 0) {
+            if (it->second)
+                return std::make_pair(&*it, false);
+            it->second = idx;
+            ++count;
+            return std::make_pair(&*it, true);
+        }
+        if (pending.size() >= std::max<std::size_t>(256, sorted.size()/8)) {
+            merge();
+            return insert(name, idx);
+        }
+        auto res = pending.emplace(name, idx);
+        if (res.second)
+            ++count;
+        return std::make_pair(&*res.first, res.second);
+    }
+
+    const value_type *find(const MappedName &name) const
+    {
+        auto iter = pending.find(name);
+        if (iter != pending.end())
+            return &*iter;
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), name,
+                [](const value_type &v, const MappedName &n) {return v.first < n;});
+        if (it != sorted.end() && it->second && it->first.compare(name) == 0)
+            return &*it;
+        return nullptr;
+    }
+
+    bool erase(const MappedName &name)
+    {
+        auto iter = pending.find(name);
+        if (iter != pending.end()) {
+            // erase by iterator, as 'name' may refer to the key itself
+            pending.erase(iter);
+            --count;
+            return true;
+        }
+        auto it = lowerBound(name);
+        if (it == sorted.end() || !it->second || it->first.compare(name) != 0)
+            return false;
+        it->second = IndexedName();
+        --count;
+        return true;
+    }
+
+    /// Call func(const value_type &) for each entry in the order of names
+    template<class Func>
+    void forEach(Func func) const
+    {
+        auto it = sorted.begin();
+        for (auto & v : pending) {
+            for (; it != sorted.end() && it->first < v.first; ++it) {
+                if (it->second)
+                    func(*it);
+            }
+            func(v);
+        }
+        for (; it != sorted.end(); ++it) {
+            if (it->second)
+                func(*it);
+        }
+    }
+
+    /// Merge all pending names, and release any extra memory
+    void compact()
+    {
+        if (pending.size() || count != sorted.size())
+            merge();
+        sorted.shrink_to_fit();
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    std::size_t getMemSize() const
+    {
+        // Rough estimation of a tree node including allocation overhead
+        const std::size_t nodeSize = sizeof(value_type) + 4*sizeof(void*) + 16;
+        return sorted.capacity() * sizeof(value_type) + pending.size() * nodeSize;
+    }
+
+private:
+    std::vector<value_type>::iterator lowerBound(const MappedName &name)
+    {
+        return std::lower_bound(sorted.begin(), sorted.end(), name,
+                [](const value_type &v, const MappedName &n) {return v.first < n;});
+    }
+
+    void merge()
+    {
+        std::vector<value_type> merged;
+        merged.reserve(count);
+        forEach([&merged](const value_type &v) {merged.push_back(v);});
+        sorted.swap(merged);
+        pending.clear();
+    }
+
+private:
+    std::vector<value_type> sorted;
+    std::map<MappedName
+             ,IndexedName
+             ,std::less<MappedName>
+#ifdef _FC_MEM_TRACE
+             ,MemoryMapAllocator<value_type>
+#endif
+            > pending;
+    std::size_t count = 0;
+};
+
 inline std::ostream & operator << (std::ostream &s, const QByteArray &bytes)
 {
     s.write(bytes.constData(), bytes.size());
@@ -368,8 +500,9 @@ public:
             }
         }
 
-        for (auto & v : this->mappedNames)
+        this->mappedNames.forEach([&](const MappedNameIndex::value_type &v) {
             addPostfix(v.first.constPostfix(), postfixMap, postfixes);
+        });
 
         childMaps.push_back(this);
         res.first->second = (int)childMaps.size();
@@ -503,11 +636,13 @@ public:
         if (map)
             return map;
 
-        std::vector<std::string> postfixes;
+        // Keep the postfixes as QByteArray so that the restored names share
+        // the same postfix data.
+        std::vector<QByteArray> postfixes;
         postfixes.reserve(count);
         for (int i=0; i < count; ++i) {
-            postfixes.emplace_back();
-            s >> postfixes.back();
+            s >> tmp;
+            postfixes.emplace_back(tmp.c_str(), static_cast<int>(tmp.size()));
         }
 
         std::vector<ElementMapPtr> childMaps;
@@ -526,7 +661,7 @@ public:
     ElementMapPtr restore(App::StringHasherRef hasher,
                           std::istream &s,
                           std::vector<ElementMapPtr> &childMaps,
-                          const std::vector<std::string> &postfixes)
+                          const std::vector<QByteArray> &postfixes)
     {
         const char * msg = "Invalid element map";
         std::string tmp;
@@ -651,7 +786,7 @@ public:
                         if (n <= 0 || n > (int)postfixes.size())
                             FC_THROWM(Base::RuntimeError, "Invalid element name index");
                         long m = strtol(tokens[1].c_str(), nullptr, 16);
-                        ref->name = MappedName(IndexedName::fromConst(postfixes[n-1].c_str(), m));
+                        ref->name = MappedName(IndexedName::fromConst(postfixes[n-1].constData(), m));
                         break;
                     }
                     case '$':
@@ -673,7 +808,7 @@ public:
                             ref->name += postfixes[n-1];
                     }
 
-                    this->mappedNames.emplace(ref->name, idx);
+                    this->mappedNames.insert(ref->name, idx);
 
                     if (!hasher) {
                         if (offset + 1 < (int)tokens.size())
@@ -712,6 +847,7 @@ public:
         if (! (s >> tmp) || tmp != "EndMap")
             FC_THROWM(Base::RuntimeError, "unexpected end of child element map");
 
+        this->mappedNames.compact();
         return shared_from_this();
     }
 
@@ -731,7 +867,7 @@ public:
         do {
             if (overwrite)
                 erase(idx);
-            auto ret = mappedNames.insert(std::make_pair(name, idx));
+            auto ret = mappedNames.insert(name, idx);
             if (ret.second) {
                 ret.first->first.compact();
                 mappedRef(idx).append(ret.first->first, sids);
@@ -755,13 +891,13 @@ public:
     bool erase(const MappedName &name)
     {
         auto it = this->mappedNames.find(name);
-        if (it == this->mappedNames.end())
+        if (!it)
             return false;
         MappedNameRef * ref = findMappedRef(it->second);
         if (!ref)
             return false;
         ref->erase(name);
-        this->mappedNames.erase(it);
+        this->mappedNames.erase(name);
         return true;
     }
 
@@ -783,7 +919,7 @@ public:
     IndexedName find(const MappedName &name, ElementIDRefs * sids = nullptr) const
     {
         auto it = mappedNames.find(name);
-        if (it == mappedNames.end()) {
+        if (!it) {
             if (childElements.isEmpty())
                 return IndexedName();
 
@@ -952,6 +1088,52 @@ public:
         return !childElements.empty();
     }
 
+    // Counts shared child maps and name data only once
+    struct MemSizeCounter
+    {
+        std::unordered_set<const ElementMap*> maps;
+        std::unordered_set<const char*> buffers;
+
+        std::size_t bytes(const QByteArray &data)
+        {
+            if (data.isEmpty() || !buffers.insert(data.constData()).second)
+                return 0;
+            // data plus the shared header allocated by QByteArray
+            return data.size() + 3*sizeof(void*);
+        }
+    };
+
+    std::size_t getMemSize(MemSizeCounter &counter) const
+    {
+        if (!counter.maps.insert(this).second)
+            return 0;
+
+        // Rough estimation of a tree node including allocation overhead
+        const std::size_t nodeSize = 4*sizeof(void*) + 16;
+        std::size_t size = sizeof(*this) + mappedNames.getMemSize();
+        for (auto & v : this->indexedNames) {
+            size += sizeof(v) + nodeSize + v.second.names.size() * sizeof(MappedNameRef);
+            for (auto & ref : v.second.names) {
+                for (auto r = &ref; r; r = r->next.get()) {
+                    if (r != &ref)
+                        size += sizeof(MappedNameRef);
+                    size += counter.bytes(r->name.dataBytes())
+                        + counter.bytes(r->name.postfixBytes())
+                        + r->sids.size() * sizeof(App::StringIDRef);
+                }
+            }
+            for (auto & vv : v.second.children) {
+                auto & child = vv.second;
+                size += sizeof(vv) + nodeSize + counter.bytes(child.postfix)
+                    + child.sids.size() * sizeof(App::StringIDRef);
+                if (child.elementMap)
+                    size += child.elementMap->getMemSize(counter);
+            }
+        }
+        size += this->childElements.size() * (sizeof(QByteArray) + sizeof(ChildMapInfo) + nodeSize);
+        return size;
+    }
+
     void hashChildMaps(ComplexGeoData & master)
     {
         if (childElements.empty() || !master.Hasher)
@@ -1168,8 +1350,9 @@ public:
     std::vector<MappedElement> getAll() const {
         std::vector<MappedElement> ret;
         ret.reserve(size());
-        for (auto &v : this->mappedNames)
+        this->mappedNames.forEach([&ret](const MappedNameIndex::value_type &v) {
             ret.emplace_back(v.first, v.second);
+        });
         for (auto &v : this->childElements) {
             auto & child = *v.childMap;
             IndexedName idx(child.indexedName);
@@ -1193,13 +1376,7 @@ public:
 private:
     std::map<const char *, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName
-             ,IndexedName
-             ,std::less<MappedName>
-#ifdef _FC_MEM_TRACE
-             ,MemoryMapAllocator<std::pair<MappedName, IndexedName> >
-#endif
-            > mappedNames;
+    MappedNameIndex mappedNames;
 
     QHash<QByteArray, ChildMapInfo> childElements;
 
@@ -1428,6 +1605,14 @@ const char *ComplexGeoData::findElementName(const char *subname) {
     return element;
 }
 
+size_t ComplexGeoData::getElementMapMemSize(bool flush) const {
+    auto map = elementMap(flush);
+    if (!map)
+        return 0;
+    ElementMap::MemSizeCounter counter;
+    return map->getMemSize(counter);
+}
+
 size_t ComplexGeoData::getElementMapSize(bool flush) const {
     if (flush) {
         flushElementMap();
@@ -2251,10 +2436,16 @@ void ComplexGeoData::RestoreDocFile(Base::Reader &reader) {
 }
 
 unsigned int ComplexGeoData::getMemSize(void) const {
-    flushElementMap();
-    if(_ElementMap)
-        return _ElementMap->size()*10;
-    return 0;
+    return static_cast<unsigned int>(getElementMapMemSize(false));
+}
+
+void ComplexGeoData::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const {
+    std::size_t mapSize = getElementMapMemSize(false);
+    std::size_t size = getMemSize();
+    if (mapSize)
+        sizes["ElementMap"] += mapSize;
+    if (size > mapSize)
+        sizes["Geometry"] += size - mapSize;
 }
 
 std::vector<IndexedName> ComplexGeoData::getHigherElements(const char *, bool) const
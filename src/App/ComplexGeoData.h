@@ -29,6 +29,7 @@
 #include <memory>
 #include <cctype>
 #include <functional>
+#include <map>
 
 #include <QVector>
 
@@ -380,6 +381,9 @@ public:
     /// Get the current element map size
     size_t getElementMapSize(bool flush=true) const;
 
+    /// Get the estimated memory usage in bytes of the element map, including child maps
+    size_t getElementMapMemSize(bool flush=true) const;
+
     /// Return the higher level element names of the given element
     virtual std::vector<IndexedName> getHigherElements(const char *name, bool silent=false) const;
 
@@ -452,6 +456,13 @@ public:
     void SaveDocFile(Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
     unsigned int getMemSize (void) const override;
+    /** Add the memory used by the data to \a sizes, split by category
+     *
+     * The default implementation reports the element map as "ElementMap" and
+     * the rest of getMemSize() as "Geometry". Measuring does not generate any
+     * element map that is still pending.
+     */
+    virtual void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const;
     void setPersistenceFileName(const char *name) const;
     virtual void beforeSave() const;
     bool isRestoreFailed() const { return _restoreFailed; }
@@ -412,6 +412,10 @@ Py::Int ComplexGeoDataPy::getElementMapSize() const {
     return Py::Int((long)getComplexGeoDataPtr()->getElementMapSize());
 }
 
+Py::Int ComplexGeoDataPy::getElementMapMemSize() const {
+    return Py::Int((long)getComplexGeoDataPtr()->getElementMapMemSize());
+}
+
 void ComplexGeoDataPy::setHasher(Py::Object obj) {
     auto self = getComplexGeoDataPtr();
     if(obj.isNone()) {
@@ -67,6 +67,9 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <boost/graph/graphviz.hpp>
 #include <boost/bimap.hpp>
 #include <boost/graph/strong_components.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
 
 #ifdef USE_OLD_DAG
 #include <boost/graph/topological_sort.hpp>
@@ -76,6 +79,11 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #endif //USE_OLD_DAG
 
 #include <boost/regex.hpp>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
@@ -85,12 +93,16 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QCoreApplication>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 #include <App/DocumentPy.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/ExceptionSafeCall.h>
 #include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
 #include <Base/TimeInfo.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -108,10 +120,13 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include "ExpressionParser.h"
 #include "GeoFeature.h"
 #include "GeoFeatureGroupExtension.h"
+#include "RecomputeProfiler.h"
 #include "Link.h"
 #include "MergeDocuments.h"
 #include "Origin.h"
 #include "OriginGroupExtension.h"
+#include "PropertyFile.h"
+#include "PropertyPythonObject.h"
 #include "StringHasher.h"
 #include "Transactions.h"
 
@@ -161,11 +176,31 @@ typedef boost::bimap<StringHasherRef,int> HasherMap;
 
 static bool globalIsRestoring;
 
+// Revision of the dependency graph of all documents, increased on any link
+// change, because dependency can go across documents.
+static std::atomic<long> _DependencyRevision;
+
 // Pimpl class
 struct DocumentP
 {
     // Array to preserve the creation order of created objects
     std::vector<DocumentObject*> objectArray;
+    // Objects of each exact type together with their creation sequence
+    std::unordered_map<unsigned int, std::vector<std::pair<long, DocumentObject*>>> objectTypeMap;
+    long objectSequence = 0;
+    // Object labels, for lookup by label with duplicates
+    struct LabelEntry {
+        DocumentObject *obj;
+        std::string label;
+        long sequence;
+    };
+    bmi::multi_index_container<
+        LabelEntry,
+        bmi::indexed_by<
+            bmi::hashed_unique<bmi::member<LabelEntry, DocumentObject*, &LabelEntry::obj>>,
+            bmi::hashed_non_unique<bmi::member<LabelEntry, std::string, &LabelEntry::label>>
+        >
+    > labelIndex;
     std::unordered_set<App::DocumentObject*> touchedObjs;
     std::unordered_map<std::string, DocumentObject*> objectMap;
     std::unordered_map<long, DocumentObject*> objectIdMap;
@@ -198,12 +233,45 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    // guard recompute log and transaction access from recompute worker threads
+    std::recursive_mutex recomputeMutex;
+
+    // Cached dependency sorted objects for full document recompute
+    std::vector<App::DocumentObject*> depOrder;
+    std::unordered_map<App::DocumentObject*, std::size_t> depOrderIndex;
+    long depGraphRevision = -1;
+    long depDocRevision = -1;
+    int depOptions = 0;
+    Document::DependencyGraphStats depStats;
 
     StringHasherRef Hasher;
 
     // restored files
     std::set<std::string> files;
 
+    // Files of each property in the archive last saved or restored, used by
+    // incremental save to copy the files of unchanged properties
+    struct SavedFiles {
+        std::vector<std::string> names;
+        bool shared = false;
+    };
+    using SavedFileMap = std::unordered_map<const Property*, SavedFiles>;
+    SavedFileMap savedFiles;
+    std::string savedArchive;
+    qint64 savedArchiveSize = -1;
+    qint64 savedArchiveTime = -1;
+    int reusedFileCount = 0;
+    // the archive currently being restored
+    std::string restoringArchive;
+
+    // Change notification batching, see Document::openChangeBatch(). The
+    // changes are recorded by object ID and property name, so that objects
+    // and dynamic properties removed inside the batch are simply skipped.
+    int changeBatch = 0;
+    std::vector<std::pair<long, std::string> > pendingChanges;
+    std::set<std::pair<long, std::string> > pendingChangeSet;
+    Document::ChangeNotificationStats changeStats;
+
     DocumentP() {
 #ifndef FC_DEBUG
         static std::random_device _RD;
@@ -245,9 +313,83 @@ struct DocumentP
         }
         ++revision;
         this->objectArray.push_back(pcObject);
+        this->objectTypeMap[pcObject->getTypeId().getKey()].emplace_back(
+                ++this->objectSequence, pcObject);
+        this->labelIndex.insert(LabelEntry{pcObject, pcObject->Label.getStrValue(), this->objectSequence});
         return id ? id : this->lastObjectId;
     }
 
+    void updateObjectLabel(const App::DocumentObject *pcObject) {
+        auto &index = labelIndex.get<0>();
+        auto it = index.find(const_cast<DocumentObject*>(pcObject));
+        if (it != index.end() && it->label != pcObject->Label.getStrValue())
+            index.modify(it, [pcObject](LabelEntry &entry) {
+                entry.label = pcObject->Label.getStrValue();
+            });
+    }
+
+    // Return the objects with the given label in creation order
+    std::vector<DocumentObject*> getObjectsByLabel(const std::string &label) const {
+        std::vector<DocumentObject*> res;
+        auto range = labelIndex.get<1>().equal_range(label);
+        if (range.first == range.second)
+            return res;
+        std::vector<std::pair<long, DocumentObject*>> objs;
+        for (auto it = range.first; it != range.second; ++it)
+            objs.emplace_back(it->sequence, it->obj);
+        if (objs.size() > 1)
+            std::sort(objs.begin(), objs.end());
+        res.reserve(objs.size());
+        for (auto &v : objs)
+            res.push_back(v.second);
+        return res;
+    }
+
+    void removeObjectIndex(App::DocumentObject *pcObject) {
+        labelIndex.get<0>().erase(pcObject);
+        auto it = objectTypeMap.find(pcObject->getTypeId().getKey());
+        if (it == objectTypeMap.end())
+            return;
+        auto &objs = it->second;
+        for (auto iter = objs.begin(); iter != objs.end(); ++iter) {
+            if (iter->second == pcObject) {
+                objs.erase(iter);
+                break;
+            }
+        }
+        if (objs.empty())
+            objectTypeMap.erase(it);
+    }
+
+    // Return the objects derived from the given type in creation order
+    std::vector<DocumentObject*> getObjectsOfType(const Base::Type &typeId) const {
+        std::vector<const std::vector<std::pair<long, DocumentObject*>>*> matches;
+        std::size_t count = 0;
+        for (auto &v : objectTypeMap) {
+            if (Base::Type::fromKey(v.first).isDerivedFrom(typeId)) {
+                matches.push_back(&v.second);
+                count += v.second.size();
+            }
+        }
+
+        std::vector<DocumentObject*> res;
+        res.reserve(count);
+        if (matches.size() == 1) {
+            for (auto &v : *matches.front())
+                res.push_back(v.second);
+            return res;
+        }
+
+        std::vector<std::pair<long, DocumentObject*>> objs;
+        objs.reserve(count);
+        for (auto match : matches)
+            objs.insert(objs.end(), match->begin(), match->end());
+        std::sort(objs.begin(), objs.end());
+        for (auto &v : objs)
+            res.push_back(v.second);
+        return res;
+    }
+
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
         addRecomputeLog(new DocumentObjectExecReturn(why, obj));
     }
@@ -261,11 +403,90 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::recursive_mutex> guard(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which, std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
     }
 
+    template<class FileList, class SharedCheck>
+    static SavedFileMap collectSavedFiles(const FileList &fileList, SharedCheck isShared) {
+        SavedFileMap res;
+        for (auto &entry : fileList) {
+            auto prop = dynamic_cast<const Property*>(entry.Owner);
+            // The string hasher is shared among properties and saved along
+            // with any of them. Python objects and included files may change
+            // without touching the property.
+            if (!prop || dynamic_cast<const StringHasher*>(entry.Object)
+                      || prop->isDerivedFrom(PropertyPythonObject::getClassTypeId())
+                      || prop->isDerivedFrom(PropertyFileIncluded::getClassTypeId()))
+                continue;
+            auto &info = res[prop];
+            info.names.push_back(entry.FileName);
+            if (isShared(entry.FileName))
+                info.shared = true;
+        }
+        return res;
+    }
+
+    void setSavedFiles(const std::string &archive, SavedFileMap &&files) {
+        clearSavedFiles();
+        QFileInfo fi(QString::fromUtf8(archive.c_str()));
+        if (!fi.exists())
+            return;
+        savedArchive = fi.canonicalFilePath().toUtf8().constData();
+        savedArchiveSize = fi.size();
+        savedArchiveTime = fi.lastModified().toMSecsSinceEpoch();
+        savedFiles = std::move(files);
+        // Property::touch() resets the status on any further change
+        for (auto &v : savedFiles)
+            const_cast<Property*>(v.first)->setStatus(Property::Saved, true);
+    }
+
+    void clearSavedFiles() {
+        savedFiles.clear();
+        savedArchive.clear();
+        savedArchiveSize = -1;
+        savedArchiveTime = -1;
+    }
+
+    bool canSaveIncremental(const std::string &archive) const {
+        if (savedArchive.empty() || !DocumentParams::getIncrementalSave())
+            return false;
+        // Make sure the archive is not modified by others since then
+        QFileInfo fi(QString::fromUtf8(archive.c_str()));
+        return fi.exists()
+            && savedArchive == fi.canonicalFilePath().toUtf8().constData()
+            && savedArchiveSize == fi.size()
+            && savedArchiveTime == fi.lastModified().toMSecsSinceEpoch();
+    }
+
+    void setupIncrementalSave(Base::ZipWriter &writer) const {
+        auto current = collectSavedFiles(writer.getFileList(),
+                                         [](const std::string &) {return false;});
+        for (auto &v : current) {
+            if (!v.first->testStatus(Property::Saved))
+                continue;
+            auto it = savedFiles.find(v.first);
+            if (it == savedFiles.end()
+                    || it->second.shared
+                    || it->second.names.size() != v.second.names.size())
+                continue;
+            const auto &names = v.second.names;
+            const auto &previous = it->second.names;
+            // File extension may change because of different saving
+            // options, e.g. PreferBinary
+            if (!std::equal(names.begin(), names.end(), previous.begin(),
+                        [](const std::string &a, const std::string &b) {
+                            return Base::FileInfo(a).extension() == Base::FileInfo(b).extension();
+                        }))
+                continue;
+            for (std::size_t i=0; i<names.size(); ++i)
+                writer.reuseFile(names[i], previous[i]);
+        }
+    }
+
     void clearRecomputeLog(const App::DocumentObject *obj=nullptr) {
+        std::lock_guard<std::recursive_mutex> guard(recomputeMutex);
         if(!obj)
             _RecomputeLog.clear();
         else
@@ -275,6 +496,8 @@ struct DocumentP
     void clearDocument() {
         activeObject = nullptr;
         objectArray.clear();
+        objectTypeMap.clear();
+        labelIndex.clear();
         decltype(objectMap) map = std::move(objectMap);
         objectMap.clear();
         objectIdMap.clear();
@@ -284,7 +507,24 @@ struct DocumentP
         }
     }
 
+    /// Collect property payloads shared with the live document, see Property::getSharedData()
+    void getSharedData(std::unordered_set<const void*> &counted) const {
+        std::vector<Property*> props;
+        for (auto obj : objectArray) {
+            props.clear();
+            obj->getPropertyList(props);
+            for (auto prop : props) {
+                if (auto shared = prop->getSharedData())
+                    counted.insert(shared);
+            }
+        }
+    }
+
+    const std::vector<App::DocumentObject*> &getDependencyOrder(int options);
+    std::vector<App::DocumentObject*> getRecomputeList(int options);
+
     const char *findRecomputeLog(const App::DocumentObject *obj) {
+        std::lock_guard<std::recursive_mutex> guard(recomputeMutex);
         auto range = _RecomputeLog.equal_range(obj);
         if(range.first == range.second)
             return nullptr;
@@ -314,6 +554,74 @@ void Document::setStatus(Status pos, bool on)
     d->StatusBits.set((size_t)pos, on);
 }
 
+void Document::openChangeBatch()
+{
+    ++d->changeBatch;
+}
+
+void Document::closeChangeBatch()
+{
+    if (d->changeBatch <= 0 || --d->changeBatch)
+        return;
+
+    ++d->changeStats.batchCount;
+
+    // Take the recorded changes first, because the slots may change more
+    // properties, which are now signaled directly.
+    auto changes = std::move(d->pendingChanges);
+    d->pendingChanges.clear();
+    d->pendingChangeSet.clear();
+
+    for (auto &change : changes) {
+        auto obj = getObjectByID(change.first);
+        if (!obj)
+            continue;
+        auto prop = obj->getPropertyByName(change.second.c_str());
+        if (!prop)
+            continue;
+        ++d->changeStats.signalCount;
+        signalChangedObject(*obj, *prop);
+    }
+}
+
+bool Document::isChangeBatchOpen() const
+{
+    return d->changeBatch > 0;
+}
+
+const Document::ChangeNotificationStats &Document::getChangeNotificationStats() const
+{
+    return d->changeStats;
+}
+
+void Document::resetChangeNotificationStats()
+{
+    d->changeStats = ChangeNotificationStats();
+}
+
+ChangeBatch::ChangeBatch(Document *doc)
+{
+    if (doc) {
+        docName = doc->getName();
+        doc->openChangeBatch();
+    }
+}
+
+ChangeBatch::~ChangeBatch()
+{
+    if (docName.empty())
+        return;
+    if (auto doc = GetApplication().getDocument(docName.c_str())) {
+        try {
+            doc->closeChangeBatch();
+        } catch (Base::Exception &e) {
+            e.ReportException();
+        } catch (...) {
+            FC_ERR("Unknown exception on closing change batch of " << docName);
+        }
+    }
+}
+
 void Document::writeDependencyGraphViz(std::ostream &out)
 {
     //  // caching vertex to DocObject
@@ -1286,6 +1594,23 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        // Drop the oldest undo steps beyond the memory limit, but always keep
+        // the one just committed.
+        if (d->UndoMemSize > 0) {
+            // Each step is only measured once, so the limit check does not
+            // walk the whole stack and document on every commit.
+            std::size_t total = 0;
+            for (auto transaction : mRedoTransactions)
+                total += transaction->getCommittedMemSize();
+            for (auto transaction : mUndoTransactions)
+                total += transaction->getCommittedMemSize();
+            while (mUndoTransactions.size() > 1 && total > d->UndoMemSize) {
+                total -= mUndoTransactions.front()->getCommittedMemSize();
+                mUndoMap.erase(mUndoTransactions.front()->getID());
+                delete mUndoTransactions.front();
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         if (notify)
@@ -1387,6 +1712,8 @@ void Document::clearDocument()
 
     d->clearRecomputeLog();
     d->objectArray.clear();
+    d->objectTypeMap.clear();
+    d->labelIndex.clear();
     d->objectMap.clear();
     d->objectIdMap.clear();
     d->lastObjectId = 0;
@@ -1476,6 +1803,23 @@ int Document::getUndoMode() const
 }
 
 unsigned int Document::getUndoMemSize () const
+{
+    // Property payloads shared with the live document (see
+    // Property::getSharedData()) cost nothing extra in the undo stack.
+    std::unordered_set<const void*> counted;
+    d->getSharedData(counted);
+
+    std::size_t size = 0;
+    if (d->activeUndoTransaction)
+        size += d->activeUndoTransaction->getMemSize(counted);
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemSize(counted);
+    for (auto it = mUndoTransactions.rbegin(); it != mUndoTransactions.rend(); ++it)
+        size += (*it)->getMemSize(counted);
+    return static_cast<unsigned int>(std::min<std::size_t>(size, UINT_MAX));
+}
+
+unsigned int Document::getUndoLimit() const
 {
     return d->UndoMemSize;
 }
@@ -1560,9 +1904,13 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Property *What)
 {
-    if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
-        signalBeforeChangeObject(*static_cast<const App::DocumentObject*>(Who), *What);
+    if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+        auto obj = static_cast<const App::DocumentObject*>(Who);
+        if (!deferRecomputeSignal([this, obj, What]() {signalBeforeChangeObject(*obj, *What);}))
+            signalBeforeChangeObject(*obj, *What);
+    }
     if(!d->rollback) {
+        std::lock_guard<std::recursive_mutex> guard(d->recomputeMutex);
         _checkTransaction(nullptr, What, __LINE__);
         if (d->activeUndoTransaction)
             d->activeUndoTransaction->addObjectChange(Who, What);
@@ -1571,6 +1919,9 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if (deferRecomputeSignal([this, Who, What]() {onChangedProperty(Who, What);}))
+        return;
+
     if (What == &Who->TreeRank) {
         if (d->treeRankRevision == d->revision) {
             long r = Who->TreeRank.getValue();
@@ -1580,6 +1931,20 @@ void Document::onChangedProperty(const DocumentObject *Who, const Property *What
                 d->treeRanks.second = r;
         }
     }
+    else if (What == &Who->Label)
+        d->updateObjectLabel(Who);
+
+    ++d->changeStats.changeCount;
+    if (d->changeBatch && What->getName()) {
+        auto change = std::make_pair(Who->getID(), std::string(What->getName()));
+        if (d->pendingChangeSet.insert(change).second)
+            d->pendingChanges.push_back(std::move(change));
+        else
+            ++d->changeStats.coalescedCount;
+        return;
+    }
+
+    ++d->changeStats.signalCount;
     signalChangedObject(*Who, *What);
 }
 
@@ -1769,16 +2134,20 @@ std::string Document::getTransientDirectoryName(const std::string& uuid, const s
 
 #define FC_DOC_SCHEMA_VER 4
 
+static std::string currentProgramVersion()
+{
+    return App::Application::Config()["BuildVersionMajor"] + "."
+        + App::Application::Config()["BuildVersionMinor"] + "R"
+        + App::Application::Config()["BuildRevision"];
+}
+
 void Document::Save (Base::Writer &writer) const
 {
     d->hashers.clear();
     addStringHasher(d->Hasher);
 
     writer.Stream() << "<Document SchemaVersion=\"" << FC_DOC_SCHEMA_VER 
-                    << "\" ProgramVersion=\""
-                    << App::Application::Config()["BuildVersionMajor"] << "."
-                    << App::Application::Config()["BuildVersionMinor"] << "R"
-                    << App::Application::Config()["BuildRevision"]
+                    << "\" ProgramVersion=\"" << currentProgramVersion()
                     << "\" FileVersion=\"" << writer.getFileVersion() 
                     << "\" Uid=\"" << Uid.getValueStr()
                     << "\" StringHasher=\"1\">\n";
@@ -2466,6 +2835,55 @@ unsigned int Document::getMemSize () const
     return size;
 }
 
+void Document::MemoryReport::add(const std::string &object, const std::string &category, std::size_t size)
+{
+    if (!size)
+        return;
+    if (!object.empty()) {
+        auto &info = objects[object];
+        info.categories[category] += size;
+        info.total += size;
+    }
+    categories[category] += size;
+    total += size;
+}
+
+Document::MemoryReport Document::getMemoryReport() const
+{
+    MemoryReport report;
+    std::unordered_set<const void*> counted;
+    std::vector<Property*> props;
+    std::map<std::string, std::size_t> sizes;
+    for (auto obj : d->objectArray) {
+        auto &info = report.objects[obj->getNameInDocument()];
+        props.clear();
+        obj->getPropertyList(props);
+        for (auto prop : props) {
+            // Copy-on-write properties may share their payload
+            if (auto shared = prop->getSharedData()) {
+                if (!counted.insert(shared).second)
+                    continue;
+            }
+            sizes.clear();
+            prop->getMemSizeDetails(sizes);
+            std::size_t size = 0;
+            for (auto &v : sizes) {
+                report.add(obj->getNameInDocument(), v.first, v.second);
+                size += v.second;
+            }
+            if (size && prop->getName())
+                info.properties[prop->getName()] += size;
+        }
+    }
+
+    report.add(std::string(), "StringHasher", d->Hasher->getMemSize());
+    report.add(std::string(), "Document", PropertyContainer::getMemSize());
+    report.add(std::string(), "UndoStack", getUndoMemSize());
+
+    signalMemoryReport(*this, report);
+    return report;
+}
+
 static std::string checkFileName(const char *file) {
     Base::FileInfo fi(file);
     if(fi.isDir())
@@ -2907,25 +3325,51 @@ bool Document::saveToFile(const char* filename) const
 
 
     std::vector<std::string> fileNames;
+    DocumentP::SavedFileMap savedFiles;
+    d->reusedFileCount = 0;
 
     // open extra scope to close ZipWriter properly
     {
         Base::ofstream file;
         std::unique_ptr<Base::Writer> _writer;
+        Base::ZipWriter *zipwriter = nullptr;
         if(archive) {
             file.open(tmp, std::ios::out | std::ios::binary);
             if (!file.is_open())
                 throw Base::FileException("Failed to open file", tmp);
-            auto zipwriter = new Base::ZipWriter(file);
+            zipwriter = new Base::ZipWriter(file);
             _writer.reset(zipwriter);
             zipwriter->setComment("FreeCAD Document");
             zipwriter->setLevel(compression);
+            if (DocumentParams::getParallelSave()) {
+                int count = DocumentParams::getSaveThreadCount();
+                zipwriter->setThreadCount(count > 0 ? count : -1);
+                zipwriter->setMaxPendingSize(
+                        std::size_t(std::max(1, DocumentParams::getSaveMaxPendingSize())) << 20);
+            }
+            // Only possible when writing into a temporary file, because the
+            // previous archive is read while saving
+            if (policy && d->canSaveIncremental(nativePath))
+                zipwriter->setPreviousArchive(nativePath);
         } else {
             _writer.reset(new Base::FileWriter(tmp.filePath().c_str()));
         }
 
         save(*_writer, archive);
         fileNames = _writer->getFilenames();
+
+        if (zipwriter) {
+            d->reusedFileCount = zipwriter->getReusedFileCount();
+            if (zipwriter->hasPreviousArchive())
+                FC_LOG("document " << getName() << " reused "
+                        << zipwriter->getReusedFileCount() << " of "
+                        << fileNames.size() << " files");
+            if (DocumentParams::getIncrementalSave())
+                savedFiles = DocumentP::collectSavedFiles(zipwriter->getFileList(),
+                        [zipwriter](const std::string &name) {
+                            return zipwriter->isSharedFile(name);
+                        });
+        }
     }
 
 
@@ -2952,6 +3396,11 @@ bool Document::saveToFile(const char* filename) const
         policy.apply(fn, nativePath);
     }
 
+    if (archive && DocumentParams::getIncrementalSave())
+        d->setSavedFiles(nativePath, std::move(savedFiles));
+    else
+        d->clearSavedFiles();
+
     signalFinishSave(*this, filename);
 
     if(!archive) {
@@ -3012,6 +3461,10 @@ void Document::save(Base::Writer &writer, bool archive) const {
     // Special handling for Gui document.
     signalSaveDocument(writer);
 
+    auto zipWriter = dynamic_cast<Base::ZipWriter*>(&writer);
+    if (zipWriter && zipWriter->hasPreviousArchive())
+        d->setupIncrementalSave(*zipWriter);
+
     // write additional files
     writer.writeFiles();
 
@@ -3057,10 +3510,23 @@ void Document::restore (const char *filename,
         //     throw Base::FileException("Invalid project file",filename);
         zipstream.reset(new zipios::ZipInputStream(filename));
         _reader.reset(new Base::ZipReader(*zipstream,filename));
+        if (objNames.empty() && DocumentParams::getIncrementalSave())
+            d->restoringArchive = filename;
         _xmlReader.reset(new Base::XMLReader(*_reader));
+        if (DocumentParams::getParallelRestore()) {
+            int count = DocumentParams::getRestoreThreadCount();
+            _xmlReader->setRestoreThreadCount(count > 0 ? count : -1);
+        }
     }
 
-    restore(*_xmlReader, delaySignal, objNames);
+    try {
+        restore(*_xmlReader, delaySignal, objNames);
+    }
+    catch (...) {
+        d->restoringArchive.clear();
+        throw;
+    }
+    d->restoringArchive.clear();
 }
 
 void Document::restore(Base::XMLReader &reader,
@@ -3085,6 +3551,8 @@ void Document::restore(Base::XMLReader &reader,
 
     d->clearRecomputeLog();
     d->objectArray.clear();
+    d->objectTypeMap.clear();
+    d->labelIndex.clear();
     d->objectMap.clear();
     d->objectIdMap.clear();
     d->lastObjectId = 0;
@@ -3132,6 +3600,20 @@ void Document::restore(Base::XMLReader &reader,
         Base::Console().Error("There were errors while loading the file. Some data might have been modified or not recovered at all. Look above for more specific information about the objects involved.\n");
     }
 
+    // Record the restored files for incremental save before afterRestore(),
+    // so that any property changed afterwards is excluded. Files written by
+    // other program version may be in a different format, and are not reused.
+    d->clearSavedFiles();
+    if (!d->restoringArchive.empty()
+            && !testStatus(Document::PartialRestore)
+            && reader.ProgramVersion == currentProgramVersion())
+    {
+        d->setSavedFiles(d->restoringArchive, DocumentP::collectSavedFiles(reader.getFileList(),
+                    [&reader](const std::string &name) {
+                        return reader.isSharedFile(name);
+                    }));
+    }
+
     if(!delaySignal)
         afterRestore();
 }
@@ -3255,6 +3737,11 @@ bool Document::isSaved() const
     return !name.empty();
 }
 
+int Document::getReusedFileCount() const
+{
+    return d->reusedFileCount;
+}
+
 /** Label is the visible name of a document shown e.g. in the windows title
  * or in the tree view. The label almost (but not always e.g. if you manually change it)
  * matches with the file name where the document is stored to.
@@ -3600,6 +4087,100 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
     return ret;
 }
 
+void Document::_touchDependencyGraph()
+{
+    ++_DependencyRevision;
+}
+
+const Document::DependencyGraphStats &Document::getDependencyGraphStats() const
+{
+    return d->depStats;
+}
+
+/*!
+  Return the dependency sorted list of all objects.
+
+  The list is cached and only rebuilt if any object is added or removed, or
+  any link is changed.
+ */
+const std::vector<App::DocumentObject*> &DocumentP::getDependencyOrder(int options)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t = Clock::now();
+    long graphRevision = _DependencyRevision;
+    if (depGraphRevision != graphRevision
+            || depDocRevision != revision
+            || depOptions != options)
+    {
+        depGraphRevision = -1;
+        depOrderIndex.clear();
+        depOrder = Document::getDependencyList(objectArray, options);
+        depOrderIndex.reserve(depOrder.size());
+        for (std::size_t i=0; i<depOrder.size(); ++i)
+            depOrderIndex.emplace(depOrder[i], i);
+        depGraphRevision = graphRevision;
+        depDocRevision = revision;
+        depOptions = options;
+
+        auto t2 = Clock::now();
+        depStats.lastRebuildTime = std::chrono::duration<double>(t2 - t).count();
+        depStats.rebuildTime += depStats.lastRebuildTime;
+        depStats.graphSize = depOrder.size();
+        ++depStats.rebuildCount;
+        FC_LOG("Rebuild dependency graph of " << depOrder.size()
+                << " objects, time: " << depStats.lastRebuildTime << 's');
+    }
+    return depOrder;
+}
+
+/*!
+  Return the objects that need to be checked for a full document recompute.
+
+  The returned list is the sub graph of the cached dependency order,
+  consisting of the touched objects, and all objects that directly or
+  indirectly depend on them, in the same order. Note that only the order is
+  cached. Finding the touched objects still scans all objects.
+ */
+std::vector<App::DocumentObject*> DocumentP::getRecomputeList(int options)
+{
+    auto rebuildCount = depStats.rebuildCount;
+    getDependencyOrder(options);
+    if (rebuildCount == depStats.rebuildCount)
+        ++depStats.reuseCount;
+    auto t = std::chrono::steady_clock::now();
+
+    std::vector<char> dirty(depOrder.size(), 0);
+    std::vector<std::size_t> stack;
+    for (std::size_t i=0; i<depOrder.size(); ++i) {
+        auto obj = depOrder[i];
+        if (obj->getNameInDocument() && (obj->isTouched() || obj->mustRecompute())) {
+            dirty[i] = 1;
+            stack.push_back(i);
+        }
+    }
+    while (!stack.empty()) {
+        auto obj = depOrder[stack.back()];
+        stack.pop_back();
+        for (auto inObj : obj->getInList()) {
+            auto it = depOrderIndex.find(inObj);
+            if (it != depOrderIndex.end() && !dirty[it->second]) {
+                dirty[it->second] = 1;
+                stack.push_back(it->second);
+            }
+        }
+    }
+
+    std::vector<App::DocumentObject*> res;
+    for (std::size_t i=0; i<depOrder.size(); ++i) {
+        if (dirty[i])
+            res.push_back(depOrder[i]);
+    }
+    depStats.lastSubGraphSize = res.size();
+    depStats.lastExtractTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t).count();
+    return res;
+}
+
 std::vector<App::Document*> Document::getDependentDocuments(bool sort) {
     return getDependentDocuments({this},sort);
 }
@@ -3803,12 +4384,20 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     }
     std::reverse(topoSortedObjects.begin(),topoSortedObjects.end());
 #else
-    auto topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
+    auto topoSortedObjects = objs.empty() ? d->getRecomputeList(DepSort|options)
+                                          : getDependencyList(objs,DepSort|options);
 #endif
+    // A full recompute only runs the touched sub graph, but checks and reports
+    // all objects afterwards, as any object may be touched while recomputing.
+    // Obtain the list on demand, because objects may be added or removed.
+    auto getCheckList = [&]() -> const std::vector<DocumentObject*> & {
+        return objs.empty() ? d->getDependencyOrder(DepSort|options) : topoSortedObjects;
+    };
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
 
     bool canAbort = DocumentParams::getCanAbortRecompute();
+    bool parallel = DocumentParams::getParallelRecompute() && topoSortedObjects.size() > 1;
 
     std::set<App::DocumentObject *> filter;
     size_t idx = 0;
@@ -3823,6 +4412,10 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             if(canAbort)
                 seq.reset(new Base::SequencerLauncher("Recompute...", topoSortedObjects.size()));
             FC_LOG("Recompute pass " << passes);
+            if (parallel && passes == 0) {
+                objectCount += _recomputeParallel(topoSortedObjects, filter, hasError, seq.get());
+                idx = topoSortedObjects.size();
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
@@ -3847,47 +4440,38 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                         continue;
                     }
                 }
-                if(obj->isTouched() || doRecompute) {
-                    signalRecomputedObject(*obj);
-                    GetApplication().signalRecomputedObject(*this, *obj);
-                    obj->purgeTouched();
-                    // Mark all dependent object with ObjectStatus::Enforce.
-                    // Note that We don't call enforceRecompute() here in order
-                    // to enable recomputation optimization (see
-                    // _recomputeFeature())
-                    for (auto inObjIt : obj->getInList()) {
-                        inObjIt->StatusBits.set(ObjectStatus::Enforce);
-                        inObjIt->StatusBits.set(ObjectStatus::Touch);
-                        if (obj->getDocument())
-                            obj->getDocument()->signalTouchedObject(*obj);
-                    }
-
-                    // give the object a chance to revert the above touching,
-                    // because for example, new objects are created with
-                    // object's execute(), and it will be safe to not touch
-                    // those objects.
-                    obj->afterRecompute();
-                }
+                if(obj->isTouched() || doRecompute)
+                    _postRecomputeFeature(obj);
                 if (seq)
                     seq->next(true);
             }
             // check if all objects are recomputed but still thouched
-            for (size_t i=0;i<topoSortedObjects.size();++i) {
-                auto obj = topoSortedObjects[i];
+            const auto &checkObjects = getCheckList();
+            bool restart = false;
+            for (size_t i=0;i<checkObjects.size();++i) {
+                auto obj = checkObjects[i];
                 obj->setStatus(ObjectStatus::Recompute2,false);
                 if(!filter.count(obj) && obj->isTouched()) {
                     if(passes>0)
                         FC_ERR(obj->getFullName() << " still touched after recompute");
                     else{
                         FC_LOG(obj->getFullName() << " still touched after recompute");
-                        if(idx>=topoSortedObjects.size()) {
+                        if(!restart) {
                             // let's start the next pass on the first touched object
+                            restart = true;
                             idx = i;
                         }
                         obj->setStatus(ObjectStatus::Recompute2,true);
                     }
                 }
             }
+            if (restart && &checkObjects != &topoSortedObjects) {
+                // The touched object may be outside of the recomputed sub
+                // graph, so run the next pass on the full list.
+                topoSortedObjects = checkObjects;
+                for (auto obj : topoSortedObjects)
+                    obj->setStatus(ObjectStatus::PendingRecompute,true);
+            }
         }
     }
     catch(Base::AbortException &e){
@@ -3905,11 +4489,14 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
         obj->setStatus(ObjectStatus::PendingRecompute,false);
         obj->setStatus(ObjectStatus::Recompute2,false);
     }
+    const auto &checkObjects = getCheckList();
+    for(auto obj : checkObjects)
+        obj->setStatus(ObjectStatus::Recompute2,false);
 
     if (aborted)
         throw Base::AbortException();
 
-    signalRecomputed(*this,topoSortedObjects);
+    signalRecomputed(*this,checkObjects);
 
     if(!d->skippedObjs.empty())
         signalSkipRecompute(*this,d->skippedObjs);
@@ -3925,6 +4512,286 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     return objectCount;
 }
 
+void Document::_postRecomputeFeature(DocumentObject *obj)
+{
+    signalRecomputedObject(*obj);
+    GetApplication().signalRecomputedObject(*this, *obj);
+    obj->purgeTouched();
+    // Mark all dependent object with ObjectStatus::Enforce.
+    // Note that We don't call enforceRecompute() here in order
+    // to enable recomputation optimization (see
+    // _recomputeFeature())
+    for (auto inObjIt : obj->getInList()) {
+        inObjIt->StatusBits.set(ObjectStatus::Enforce);
+        inObjIt->StatusBits.set(ObjectStatus::Touch);
+        if (obj->getDocument())
+            obj->getDocument()->signalTouchedObject(*obj);
+    }
+
+    // give the object a chance to revert the above touching,
+    // because for example, new objects are created with
+    // object's execute(), and it will be safe to not touch
+    // those objects.
+    obj->afterRecompute();
+}
+
+namespace {
+
+// Signals queued by the recompute job running in the current thread
+thread_local std::vector<std::function<void()> > *_DeferredSignals;
+
+struct RecomputeJob;
+
+struct RecomputeJobQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<RecomputeJob*> finished;
+};
+
+struct RecomputeJob : QRunnable {
+    DocumentObject *obj;
+    std::function<int()> work;
+    RecomputeJobQueue *queue;
+    std::vector<std::function<void()> > signals;
+    int result = 0;
+    bool aborted = false;
+
+    RecomputeJob(DocumentObject *obj, std::function<int()> &&work, RecomputeJobQueue *queue)
+        :obj(obj), work(std::move(work)), queue(queue)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        _DeferredSignals = &signals;
+        try {
+            result = work();
+        } catch (Base::AbortException &) {
+            aborted = true;
+        } catch (...) {
+            // _recomputeFeature() shall already handle all other exceptions
+            result = 1;
+        }
+        _DeferredSignals = nullptr;
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->finished.push_back(this);
+        queue->cv.notify_one();
+    }
+};
+
+QThreadPool &recomputePool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
+bool canRecomputeInThread(const Document *doc, DocumentObject *obj)
+{
+    if (obj->getDocument() != doc
+            || !obj->canRecomputeInThread()
+            || obj->ExpressionEngine.numExpressions())
+        return false;
+    for (auto ext : obj->getExtensionsDerivedFromType<App::Extension>()) {
+        if (ext->isPythonExtension())
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool Document::deferRecomputeSignal(std::function<void()> &&callback)
+{
+    if (!_DeferredSignals)
+        return false;
+    if (callback)
+        _DeferredSignals->push_back(std::move(callback));
+    return true;
+}
+
+bool Document::isRecomputeWorker()
+{
+    return _DeferredSignals != nullptr;
+}
+
+int Document::_recomputeParallel(const std::vector<App::DocumentObject*> &objs,
+                                 std::set<App::DocumentObject*> &filter,
+                                 bool *hasError,
+                                 Base::SequencerLauncher *seq)
+{
+    // Schedule the objects by counting the number of their dependencies
+    // (i.e. out list) inside the recompute queue. An object is ready once all
+    // of its dependencies are done.
+    std::unordered_map<DocumentObject*, int> depCount;
+    for (auto obj : objs)
+        depCount.emplace(obj, 0);
+    for (auto obj : objs) {
+        std::set<DocumentObject*> deps(obj->getOutList().begin(), obj->getOutList().end());
+        for (auto dep : deps) {
+            if (depCount.count(dep))
+                ++depCount[obj];
+        }
+    }
+
+    // Objects that must run in the main thread are queued separately, and
+    // only run when no worker is busy, because they may trigger arbitrary
+    // code (Python, Gui observers) that can peek into other objects.
+    std::deque<DocumentObject*> ready, readyMain;
+    auto pushReady = [&](DocumentObject *obj) {
+        if (canRecomputeInThread(this, obj))
+            ready.push_back(obj);
+        else
+            readyMain.push_back(obj);
+    };
+    for (auto obj : objs) {
+        if (!depCount[obj])
+            pushReady(obj);
+    }
+
+    auto release = [&](DocumentObject *obj) {
+        std::set<DocumentObject*> inList(obj->getInList().begin(), obj->getInList().end());
+        for (auto inObj : inList) {
+            auto it = depCount.find(inObj);
+            if (it != depCount.end() && --it->second == 0)
+                pushReady(inObj);
+        }
+        if (seq)
+            seq->next(true);
+    };
+
+    auto finish = [&](DocumentObject *obj, int res) {
+        if (res) {
+            if (hasError)
+                *hasError = true;
+            // if something happened filter all object in its inListRecursive
+            // from the queue then proceed
+            obj->getInListEx(filter, true);
+            filter.insert(obj);
+        }
+        else
+            _postRecomputeFeature(obj);
+        release(obj);
+    };
+
+    int maxThreads = DocumentParams::getRecomputeThreadCount();
+    if (maxThreads <= 0)
+        maxThreads = QThread::idealThreadCount();
+    recomputePool().setMaxThreadCount(std::max(1, maxThreads));
+
+    RecomputeJobQueue queue;
+    std::vector<std::unique_ptr<RecomputeJob> > jobs;
+    int running = 0;
+    int count = 0;
+    bool aborted = false;
+
+    // Shape features of the workers name their elements through the string
+    // hasher of this document
+    struct ConcurrentHasher {
+        StringHasherRef hasher;
+        bool concurrent;
+        explicit ConcurrentHasher(const StringHasherRef &h)
+            :hasher(h), concurrent(h->isConcurrent())
+        {
+            hasher->setConcurrent(true);
+        }
+        ~ConcurrentHasher() {
+            hasher->setConcurrent(concurrent);
+        }
+    } concurrentHasher(getHasher());
+
+    auto waitJobs = [&](bool all) {
+        std::vector<RecomputeJob*> finished;
+        {
+            // worker may need the GIL, e.g. for reporting error through a
+            // Python console observer
+            std::unique_ptr<Base::PyGILStateRelease> gil;
+            if (PyGILState_Check())
+                gil.reset(new Base::PyGILStateRelease);
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.cv.wait(lock, [&]() {
+                return all ? (int)queue.finished.size() == running : !queue.finished.empty();
+            });
+            finished.swap(queue.finished);
+        }
+        running -= (int)finished.size();
+        return finished;
+    };
+
+    FC_TIME_INIT(t);
+    try {
+        while (!ready.empty() || !readyMain.empty() || running) {
+            while (!ready.empty() && running < maxThreads) {
+                auto obj = ready.front();
+                ready.pop_front();
+                if (!obj->getNameInDocument() || filter.count(obj)) {
+                    release(obj);
+                    continue;
+                }
+                if (!obj->mustRecompute()) {
+                    if (obj->isTouched())
+                        _postRecomputeFeature(obj);
+                    release(obj);
+                    continue;
+                }
+                ++count;
+                jobs.emplace_back(new RecomputeJob(obj,
+                            [this, obj]() {return _recomputeFeature(obj);}, &queue));
+                ++running;
+                recomputePool().start(jobs.back().get());
+            }
+
+            if (!running) {
+                if (readyMain.empty())
+                    continue;
+                auto obj = readyMain.front();
+                readyMain.pop_front();
+                if (!obj->getNameInDocument() || filter.count(obj)) {
+                    release(obj);
+                    continue;
+                }
+                bool doRecompute = obj->mustRecompute();
+                if (doRecompute) {
+                    ++count;
+                    int res = _recomputeFeature(obj);
+                    if (res) {
+                        finish(obj, res);
+                        continue;
+                    }
+                }
+                if (obj->isTouched() || doRecompute)
+                    _postRecomputeFeature(obj);
+                release(obj);
+                continue;
+            }
+
+            for (auto job : waitJobs(false)) {
+                for (auto &signal : job->signals)
+                    signal();
+                job->signals.clear();
+                if (job->aborted) {
+                    aborted = true;
+                    continue;
+                }
+                finish(job->obj, job->result);
+            }
+            if (aborted)
+                throw Base::AbortException();
+        }
+    } catch (...) {
+        // make sure no worker is running before bailing out
+        if (running) {
+            for (auto job : waitJobs(true)) {
+                for (auto &signal : job->signals)
+                    signal();
+            }
+        }
+        throw;
+    }
+    FC_TIME_LOG(t, "Parallel recompute " << count << " objects with max "
+            << maxThreads << " threads");
+    return count;
+}
+
 void Document::clearPendingRemove()
 {
     for (auto doc : GetApplication().getDocuments()) {
@@ -4134,6 +5001,7 @@ void Document::setErrorDescription(App::Property *Prop, const char *msg)
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
     DocumentObjectExecReturn  *returnCode = DocumentObject::StdReturn;
+    RecomputeProfiler::Scope profileScope("recompute", nullptr, Feat);
 
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
@@ -4154,10 +5022,12 @@ int Document::_recomputeFeature(DocumentObject* Feat)
             }
 
             if(!doRecompute && Feat->skipRecompute()) {
+                std::lock_guard<std::recursive_mutex> guard(d->recomputeMutex);
                 d->skippedObjs.push_back(Feat);
                 FC_LOG("Skip recomputing " << Feat->getFullName());
             } else {
                 Feat->_enforceRecompute = false;
+                RecomputeProfiler::Scope scope("execute", Feat->getTypeId().getName(), Feat);
                 returnCode = Feat->recompute();
             }
 
@@ -4585,6 +5455,7 @@ void Document::removeObject(const char* sName)
             break;
         }
     }
+    d->removeObjectIndex(pos->second);
 
     // In case the object gets deleted the pointer must be nullified
     if (tobedestroyed) {
@@ -4654,6 +5525,7 @@ void Document::_removeObject(DocumentObject* pcObject)
     pcObject->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pcObject->_Id);
     ++d->revision;
+    d->removeObjectIndex(pcObject);
     for (std::vector<DocumentObject*>::iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
         if (*it == pcObject) {
             d->objectArray.erase(it);
@@ -5034,14 +5906,16 @@ const std::vector<DocumentObject*> &Document::getObjects() const
 }
 
 
+std::vector<DocumentObject*> Document::getObjectsByLabel(const char *label) const
+{
+    if (!label)
+        return {};
+    return d->getObjectsByLabel(label);
+}
+
 std::vector<DocumentObject*> Document::getObjectsOfType(const Base::Type& typeId) const
 {
-    std::vector<DocumentObject*> Objects;
-    for (std::vector<DocumentObject*>::const_iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
-        if ((*it)->getTypeId().isDerivedFrom(typeId))
-            Objects.push_back(*it);
-    }
-    return Objects;
+    return d->getObjectsOfType(typeId);
 }
 
 std::vector< DocumentObject* > Document::getObjectsWithExtension(const Base::Type& typeId, bool derived) const {
@@ -5067,20 +5941,14 @@ std::vector<DocumentObject*> Document::findObjects(const Base::Type& typeId, con
         rx_label.set_expression(label);
 
     std::vector<DocumentObject*> Objects;
-    DocumentObject* found = nullptr;
-    for (std::vector<DocumentObject*>::const_iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
-        if ((*it)->getTypeId().isDerivedFrom(typeId)) {
-            found = *it;
-
-            if (!rx_name.empty() && !boost::regex_search((*it)->getNameInDocument(), what, rx_name))
-                found = nullptr;
+    for (auto obj : d->getObjectsOfType(typeId)) {
+        if (!rx_name.empty() && !boost::regex_search(obj->getNameInDocument(), what, rx_name))
+            continue;
 
-            if (!rx_label.empty() && !boost::regex_search((*it)->Label.getValue(), what, rx_label))
-                found = nullptr;
+        if (!rx_label.empty() && !boost::regex_search(obj->Label.getValue(), what, rx_label))
+            continue;
 
-            if (found)
-                Objects.push_back(found);
-        }
+        Objects.push_back(obj);
     }
     return Objects;
 }
@@ -5088,9 +5956,9 @@ std::vector<DocumentObject*> Document::findObjects(const Base::Type& typeId, con
 int Document::countObjectsOfType(const Base::Type& typeId) const
 {
     int ct=0;
-    for (auto it = d->objectMap.begin(); it != d->objectMap.end(); ++it) {
-        if (it->second->getTypeId().isDerivedFrom(typeId))
-            ct++;
+    for (auto &v : d->objectTypeMap) {
+        if (Base::Type::fromKey(v.first).isDerivedFrom(typeId))
+            ct += static_cast<int>(v.second.size());
     }
 
     return ct;
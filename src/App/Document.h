@@ -27,8 +27,10 @@
 #include "PropertyLinks.h"
 #include "PropertyStandard.h"
 
+#include <functional>
 #include <memory>
 #include <map>
+#include <set>
 #include <vector>
 #include <QString>
 
@@ -36,6 +38,7 @@ class QByteArray;
 
 namespace Base {
     class Writer;
+    class SequencerLauncher;
 }
 
 namespace App
@@ -242,6 +245,8 @@ public:
     //void open (void);
     /// Is the document already saved to a file?
     bool isSaved() const;
+    /// Number of files copied from the previous archive by the last incremental save
+    int getReusedFileCount() const;
     /// Get the document name
     const char* getName() const;
     /** Returned filename
@@ -269,6 +274,36 @@ public:
     /// returns the complete document memory consumption, including all managed DocObjects and Undo Redo.
     unsigned int getMemSize () const override;
 
+    /// Memory used by the document, see getMemoryReport()
+    struct MemoryReport {
+        struct ObjectInfo {
+            /// memory in bytes used by the object
+            std::size_t total = 0;
+            /// memory used by each property
+            std::map<std::string, std::size_t> properties;
+            /// memory used by each category, e.g. "BRep", "ElementMap"
+            std::map<std::string, std::size_t> categories;
+        };
+        /// memory in bytes used by the document
+        std::size_t total = 0;
+        /// memory used by each category, including "StringHasher" and "UndoStack"
+        std::map<std::string, std::size_t> categories;
+        /// information of each object, by object name
+        std::map<std::string, ObjectInfo> objects;
+
+        /// Add memory used by an object, or by the document if object is empty
+        void add(const std::string &object, const std::string &category, std::size_t size);
+    };
+    /** Return the memory used by the document, split by object, property and category
+     *
+     * Data shared between properties is only counted once. The report is
+     * passed to signalMemoryReport, so that e.g. the view providers can add
+     * their memory.
+     */
+    MemoryReport getMemoryReport() const;
+    /// signal to add further memory usage to a report, see getMemoryReport()
+    boost::signals2::signal<void (const App::Document&, MemoryReport&)> signalMemoryReport;
+
     /** @name Object handling  */
     //@{
     /** Add a feature of sType with sName (ASCII) to this document and set it active.
@@ -353,6 +388,8 @@ public:
     std::vector<DocumentObject*> getDependingObjects() const;
     /// Returns a list of all Objects
     const std::vector<DocumentObject*> &getObjects() const;
+    /// Returns the objects with the given label in creation order
+    std::vector<DocumentObject*> getObjectsByLabel(const char *label) const;
     std::vector<DocumentObject*> getObjectsOfType(const Base::Type& typeId) const;
     /// Returns all object with given extensions. If derived=true also all objects with extensions derived from the given one
     std::vector<DocumentObject*> getObjectsWithExtension(const Base::Type& typeId, bool derived = true) const;
@@ -400,6 +437,42 @@ public:
     void setStatus(Status pos, bool on);
     //@}
 
+    /** @name Change notification batching
+     */
+    //@{
+    /** Open a change batch
+     *
+     * While a batch is open, signalChangedObject is not emitted on each
+     * property change of the objects in this document. Each changed property
+     * is recorded once instead, and signaled in the order of its first change
+     * when the outermost batch is closed. The objects still handle their own
+     * changes, i.e. DocumentObject::onChanged(), immediately.
+     *
+     * @sa ChangeBatch
+     */
+    void openChangeBatch();
+    /// Close a change batch, and signal the recorded changes if it is the outermost one
+    void closeChangeBatch();
+    /// Check whether a change batch is open
+    bool isChangeBatchOpen() const;
+
+    /// Statistics of the change notifications of the objects in this document
+    struct ChangeNotificationStats {
+        /// number of property changes notified by the objects
+        long changeCount = 0;
+        /// number of emitted signalChangedObject
+        long signalCount = 0;
+        /// number of changes merged into an already recorded one of a batch
+        long coalescedCount = 0;
+        /// number of closed outermost batches
+        long batchCount = 0;
+    };
+    /// Return the statistics of the change notifications
+    const ChangeNotificationStats &getChangeNotificationStats() const;
+    /// Reset the statistics of the change notifications
+    void resetChangeNotificationStats();
+    //@}
+
 
     /** @name methods for the UNDO REDO and Transaction handling
      *
@@ -446,9 +519,19 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /** Set the Undo limit in Byte!
+     *
+     * The oldest undo steps are discarded on commit when the memory used by
+     * the undo/redo stack exceeds this limit. Zero means no limit.
+     */
     void setUndoLimit(unsigned int UndoMemSize=0);
-    /// Returns the actual memory consumption of the Undo redo stuff.
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit() const;
+    /** Returns the actual memory consumption of the Undo redo stuff.
+     *
+     * Property data shared between the undo/redo stack and the document,
+     * or between several undo steps, is only counted once.
+     */
     unsigned int getUndoMemSize () const;
     /// Set the Undo limit as stack size
     void setMaxUndoStackSize(unsigned int UndoMaxStackSize=20);
@@ -504,6 +587,26 @@ public:
     static std::vector<App::DocumentObject*> getDependencyList(
             const std::vector<App::DocumentObject*> &objs, int options=0);
 
+    /// Statistics of the cached dependency graph used by recompute()
+    struct DependencyGraphStats {
+        /// number of times the cached graph is rebuilt
+        long rebuildCount = 0;
+        /// number of times the cached graph is reused
+        long reuseCount = 0;
+        /// accumulated time in seconds spent on rebuilding the graph
+        double rebuildTime = 0.0;
+        /// time in seconds spent on the last rebuild
+        double lastRebuildTime = 0.0;
+        /// time in seconds spent on the last dirty sub graph extraction
+        double lastExtractTime = 0.0;
+        /// number of objects in the cached graph
+        std::size_t graphSize = 0;
+        /// number of objects extracted for the last recompute
+        std::size_t lastSubGraphSize = 0;
+    };
+    /// Return the statistics of the cached dependency graph used by recompute()
+    const DependencyGraphStats &getDependencyGraphStats() const;
+
     std::vector<App::Document*> getDependentDocuments(bool sort=true);
     static std::vector<App::Document*> getDependentDocuments(std::vector<App::Document*> docs, bool sort);
 
@@ -586,6 +689,21 @@ public:
     /// Indicate if there is any document recomputing
     static bool isAnyRecomputing();
 
+    /** Defer a signal emitted from a parallel recompute worker thread
+     *
+     * @param callback: the callback to be invoked in the main thread
+     *
+     * @return Return true if the calling thread is a recompute worker, in
+     * which case the callback is queued and invoked in the main thread after
+     * the current object finishes recompute. Return false if calling from the
+     * main thread, and the callback is discarded. The caller is expected to
+     * emit the signal directly in this case.
+     */
+    static bool deferRecomputeSignal(std::function<void()> &&callback);
+
+    /// Check if the calling thread is recomputing an object in parallel recompute
+    static bool isRecomputeWorker();
+
     long getLastObjectId() const;
     void setLastObjectId(long id); 
 
@@ -635,6 +753,13 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper to signal and mark dependent objects after the feature is recomputed
+    void _postRecomputeFeature(DocumentObject* Feat);
+    /** helper to recompute the given sorted objects using worker threads
+     * @return the number of recomputed objects
+     */
+    int _recomputeParallel(const std::vector<App::DocumentObject*> &objs,
+            std::set<App::DocumentObject*> &filter, bool *hasError, Base::SequencerLauncher *seq);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -661,6 +786,9 @@ protected:
 
     void _addOrRemoveProperty(TransactionalObject*, Property *prop, bool add);
 
+    /// Called by DocumentObject to invalidate cached dependency graph of all documents
+    static void _touchDependencyGraph();
+
 private:
     // # Data Member of the document +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     std::list<Transaction*> mUndoTransactions;
@@ -674,6 +802,25 @@ private:
     std::string myName;
 };
 
+/// Helper class to keep a change batch of a document open during its life time
+class AppExport ChangeBatch {
+private:
+    /// Private new operator to prevent heap allocation
+    void* operator new (std::size_t) = delete;
+
+public:
+    /// Open a change batch of the given document, see Document::openChangeBatch()
+    explicit ChangeBatch(Document *doc);
+    /// Close the change batch, if the document still exists
+    ~ChangeBatch();
+
+    ChangeBatch(const ChangeBatch&) = delete;
+    ChangeBatch &operator=(const ChangeBatch&) = delete;
+
+private:
+    std::string docName;
+};
+
 template<typename T>
 inline std::vector<T*> Document::getObjectsOfType() const
 {
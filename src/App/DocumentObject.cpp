@@ -101,6 +101,7 @@ DocumentObject::DocumentObject()
 
 DocumentObject::~DocumentObject()
 {
+    Document::_touchDependencyGraph();
     if (!PythonObject.is(Py::_None())){
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -232,7 +233,7 @@ void DocumentObject::touch(bool noRecompute)
         _enforceRecompute = true;
     }
     StatusBits.set(ObjectStatus::Touch);
-    if (_pDoc)
+    if (_pDoc && !Document::deferRecomputeSignal([this]() {_pDoc->signalTouchedObject(*this);}))
         _pDoc->signalTouchedObject(*this);
 }
 
@@ -780,7 +781,8 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (_pDoc)
         onBeforeChangeProperty(_pDoc, prop);
 
-    signalBeforeChange(*this,*prop);
+    if (!Document::deferRecomputeSignal([this, prop]() {signalBeforeChange(*this,*prop);}))
+        signalBeforeChange(*this,*prop);
 }
 
 void DocumentObject::onEarlyChange(const Property *prop)
@@ -815,7 +817,8 @@ void DocumentObject::onChanged(const Property* prop)
     // if (_pDoc)
     //     _pDoc->onChangedProperty(this,prop);
 
-    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue())
+    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue()
+            && !Document::deferRecomputeSignal([this]() {_pDoc->signalRelabelObject(*this);}))
         _pDoc->signalRelabelObject(*this);
 
     // set object touched if it is an input property
@@ -849,7 +852,8 @@ void DocumentObject::onChanged(const Property* prop)
     if (_pDoc)
         _pDoc->onChangedProperty(this,prop);
 
-    signalChanged(*this,*prop);
+    if (!Document::deferRecomputeSignal([this, prop]() {signalChanged(*this,*prop);}))
+        signalChanged(*this,*prop);
 }
 
 void DocumentObject::clearOutListCache() const {
@@ -1210,8 +1214,10 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
     //do not use erase-remove idom, as this erases ALL entries that match. we only want to remove a
     //single one.
     auto it = std::find(_inList.begin(), _inList.end(), rmvObj);
-    if(it != _inList.end())
+    if(it != _inList.end()) {
         _inList.erase(it);
+        Document::_touchDependencyGraph();
+    }
 #else
     (void)rmvObj;
 #endif
@@ -1225,6 +1231,7 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     //this removal would clear the object from the inlist, even though there may be other link properties 
     //from this object that link to us.
     _inList.push_back(newObj);
+    Document::_touchDependencyGraph();
 #else
     (void)newObj;
 #endif //USE_OLD_DAG    
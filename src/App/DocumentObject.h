@@ -620,6 +620,22 @@ public:
      */
     virtual int canLoadPartial() const {return 0;}
 
+    /** Whether this object can be recomputed in a worker thread
+     *
+     * @return Return true if execute() of this object is thread safe. The
+     * object is then allowed to be dispatched to a worker thread when parallel
+     * recompute is enabled (see DocumentParams::getParallelRecompute()).
+     *
+     * A thread safe execute() must not touch Python, and must only modify
+     * its own (non-link) properties. Property change notifications are
+     * automatically deferred and delivered in the main thread once the object
+     * finishes recompute. Objects with expressions or Python extensions are
+     * always recomputed in the main thread regardless of this function. The
+     * string hasher of the document is put in concurrent mode (see
+     * StringHasher::setConcurrent()) during parallel recompute.
+     */
+    virtual bool canRecomputeInThread() const {return false;}
+
     virtual void onUpdateElementReference(const Property *) {}
 
     /** Allow object to redirect a subname path
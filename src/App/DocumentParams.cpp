@@ -75,6 +75,15 @@ public:
         signalParamChanged("RelativeStringID");
         signalParamChanged("HashIndexedName");
         signalParamChanged("EnableMaterialEdit");
+        signalParamChanged("ParallelRecompute");
+        signalParamChanged("RecomputeThreadCount");
+        signalParamChanged("ParallelSave");
+        signalParamChanged("SaveThreadCount");
+        signalParamChanged("SaveMaxPendingSize");
+        signalParamChanged("ParallelRestore");
+        signalParamChanged("RestoreThreadCount");
+        signalParamChanged("IncrementalSave");
+        signalParamChanged("CompileExpressions");
 
     // Auto generated code (Tools/params_utils.py:194)
     }
@@ -107,6 +116,15 @@ public:
     bool RelativeStringID;
     bool HashIndexedName;
     bool EnableMaterialEdit;
+    bool ParallelRecompute;
+    long RecomputeThreadCount;
+    bool ParallelSave;
+    long SaveThreadCount;
+    long SaveMaxPendingSize;
+    bool ParallelRestore;
+    long RestoreThreadCount;
+    bool IncrementalSave;
+    bool CompileExpressions;
 
     // Auto generated code (Tools/params_utils.py:203)
     DocumentParamsP() {
@@ -171,6 +189,24 @@ public:
         funcs["HashIndexedName"] = &DocumentParamsP::updateHashIndexedName;
         EnableMaterialEdit = handle->GetBool("EnableMaterialEdit", true);
         funcs["EnableMaterialEdit"] = &DocumentParamsP::updateEnableMaterialEdit;
+        ParallelRecompute = handle->GetBool("ParallelRecompute", false);
+        funcs["ParallelRecompute"] = &DocumentParamsP::updateParallelRecompute;
+        RecomputeThreadCount = handle->GetInt("RecomputeThreadCount", 0);
+        funcs["RecomputeThreadCount"] = &DocumentParamsP::updateRecomputeThreadCount;
+        ParallelSave = handle->GetBool("ParallelSave", false);
+        funcs["ParallelSave"] = &DocumentParamsP::updateParallelSave;
+        SaveThreadCount = handle->GetInt("SaveThreadCount", 0);
+        funcs["SaveThreadCount"] = &DocumentParamsP::updateSaveThreadCount;
+        SaveMaxPendingSize = handle->GetInt("SaveMaxPendingSize", 256);
+        funcs["SaveMaxPendingSize"] = &DocumentParamsP::updateSaveMaxPendingSize;
+        ParallelRestore = handle->GetBool("ParallelRestore", false);
+        funcs["ParallelRestore"] = &DocumentParamsP::updateParallelRestore;
+        RestoreThreadCount = handle->GetInt("RestoreThreadCount", 0);
+        funcs["RestoreThreadCount"] = &DocumentParamsP::updateRestoreThreadCount;
+        IncrementalSave = handle->GetBool("IncrementalSave", false);
+        funcs["IncrementalSave"] = &DocumentParamsP::updateIncrementalSave;
+        CompileExpressions = handle->GetBool("CompileExpressions", true);
+        funcs["CompileExpressions"] = &DocumentParamsP::updateCompileExpressions;
     }
 
     // Auto generated code (Tools/params_utils.py:217)
@@ -305,6 +341,42 @@ public:
     static void updateEnableMaterialEdit(DocumentParamsP *self) {
         self->EnableMaterialEdit = self->handle->GetBool("EnableMaterialEdit", true);
     }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateParallelRecompute(DocumentParamsP *self) {
+        self->ParallelRecompute = self->handle->GetBool("ParallelRecompute", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateRecomputeThreadCount(DocumentParamsP *self) {
+        self->RecomputeThreadCount = self->handle->GetInt("RecomputeThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateParallelSave(DocumentParamsP *self) {
+        self->ParallelSave = self->handle->GetBool("ParallelSave", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateSaveThreadCount(DocumentParamsP *self) {
+        self->SaveThreadCount = self->handle->GetInt("SaveThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateSaveMaxPendingSize(DocumentParamsP *self) {
+        self->SaveMaxPendingSize = self->handle->GetInt("SaveMaxPendingSize", 256);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateParallelRestore(DocumentParamsP *self) {
+        self->ParallelRestore = self->handle->GetBool("ParallelRestore", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateRestoreThreadCount(DocumentParamsP *self) {
+        self->RestoreThreadCount = self->handle->GetInt("RestoreThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateIncrementalSave(DocumentParamsP *self) {
+        self->IncrementalSave = self->handle->GetBool("IncrementalSave", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateCompileExpressions(DocumentParamsP *self) {
+        self->CompileExpressions = self->handle->GetBool("CompileExpressions", true);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:256)
@@ -1115,4 +1187,270 @@ void DocumentParams::setEnableMaterialEdit(const bool &v) {
 void DocumentParams::removeEnableMaterialEdit() {
     instance()->handle->RemoveBool("EnableMaterialEdit");
 }
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docParallelRecompute() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Recompute independent objects concurrently in worker threads. Only objects\n"
+"that declare thread safe recompute are dispatched to the workers, e.g. the\n"
+"shape features of the Part workbench.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & DocumentParams::getParallelRecompute() {
+    return instance()->ParallelRecompute;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & DocumentParams::defaultParallelRecompute() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setParallelRecompute(const bool &v) {
+    instance()->handle->SetBool("ParallelRecompute",v);
+    instance()->ParallelRecompute = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeParallelRecompute() {
+    instance()->handle->RemoveBool("ParallelRecompute");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docRecomputeThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of worker threads used by parallel recompute. Zero means\n"
+"using the ideal thread count of the machine.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & DocumentParams::getRecomputeThreadCount() {
+    return instance()->RecomputeThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & DocumentParams::defaultRecomputeThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setRecomputeThreadCount(const long &v) {
+    instance()->handle->SetInt("RecomputeThreadCount",v);
+    instance()->RecomputeThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeRecomputeThreadCount() {
+    instance()->handle->RemoveInt("RecomputeThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docParallelSave() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Compress the document files concurrently in worker threads when saving.\n"
+"The files are still serialized and written in order, so the resulting\n"
+"archive is unchanged.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & DocumentParams::getParallelSave() {
+    return instance()->ParallelSave;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & DocumentParams::defaultParallelSave() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setParallelSave(const bool &v) {
+    instance()->handle->SetBool("ParallelSave",v);
+    instance()->ParallelSave = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeParallelSave() {
+    instance()->handle->RemoveBool("ParallelSave");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docSaveThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of worker threads used by parallel save. Zero means\n"
+"using the ideal thread count of the machine.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & DocumentParams::getSaveThreadCount() {
+    return instance()->SaveThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & DocumentParams::defaultSaveThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setSaveThreadCount(const long &v) {
+    instance()->handle->SetInt("SaveThreadCount",v);
+    instance()->SaveThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeSaveThreadCount() {
+    instance()->handle->RemoveInt("SaveThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docSaveMaxPendingSize() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum size in MB of serialized document files waiting to be compressed\n"
+"and written during parallel save.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & DocumentParams::getSaveMaxPendingSize() {
+    return instance()->SaveMaxPendingSize;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & DocumentParams::defaultSaveMaxPendingSize() {
+    const static long def = 256;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setSaveMaxPendingSize(const long &v) {
+    instance()->handle->SetInt("SaveMaxPendingSize",v);
+    instance()->SaveMaxPendingSize = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeSaveMaxPendingSize() {
+    instance()->handle->RemoveInt("SaveMaxPendingSize");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docParallelRestore() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Decode the document files concurrently in worker threads when restoring.\n"
+"Only files of properties that support thread safe decoding are dispatched\n"
+"to the workers, e.g. Part shapes.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & DocumentParams::getParallelRestore() {
+    return instance()->ParallelRestore;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & DocumentParams::defaultParallelRestore() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setParallelRestore(const bool &v) {
+    instance()->handle->SetBool("ParallelRestore",v);
+    instance()->ParallelRestore = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeParallelRestore() {
+    instance()->handle->RemoveBool("ParallelRestore");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docRestoreThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of worker threads used by parallel restore. Zero means\n"
+"using the ideal thread count of the machine.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & DocumentParams::getRestoreThreadCount() {
+    return instance()->RestoreThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & DocumentParams::defaultRestoreThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setRestoreThreadCount(const long &v) {
+    instance()->handle->SetInt("RestoreThreadCount",v);
+    instance()->RestoreThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeRestoreThreadCount() {
+    instance()->handle->RemoveInt("RestoreThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docIncrementalSave() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Copy the compressed files of unchanged properties from the previously saved\n"
+"or restored archive instead of serializing them again. Requires the backup\n"
+"policy, because the new archive is written into a temporary file first.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & DocumentParams::getIncrementalSave() {
+    return instance()->IncrementalSave;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & DocumentParams::defaultIncrementalSave() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setIncrementalSave(const bool &v) {
+    instance()->handle->SetBool("IncrementalSave",v);
+    instance()->IncrementalSave = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeIncrementalSave() {
+    instance()->handle->RemoveBool("IncrementalSave");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *DocumentParams::docCompileExpressions() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Evaluate the arithmetic part of property expressions natively without going\n"
+"through Python. Expressions using other constructs are still evaluated with\n"
+"Python where needed.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & DocumentParams::getCompileExpressions() {
+    return instance()->CompileExpressions;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & DocumentParams::defaultCompileExpressions() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void DocumentParams::setCompileExpressions(const bool &v) {
+    instance()->handle->SetBool("CompileExpressions",v);
+    instance()->CompileExpressions = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void DocumentParams::removeCompileExpressions() {
+    instance()->handle->RemoveBool("CompileExpressions");
+}
 //[[[end]]]
@@ -364,6 +364,128 @@ public:
     static const char *docEnableMaterialEdit();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter ParallelRecompute
+    ///
+    /// Recompute independent objects concurrently in worker threads. Only objects
+    /// that declare thread safe recompute are dispatched to the workers, e.g. the
+    /// shape features of the Part workbench.
+    static const bool & getParallelRecompute();
+    static const bool & defaultParallelRecompute();
+    static void removeParallelRecompute();
+    static void setParallelRecompute(const bool &v);
+    static const char *docParallelRecompute();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter RecomputeThreadCount
+    ///
+    /// Maximum number of worker threads used by parallel recompute. Zero means
+    /// using the ideal thread count of the machine.
+    static const long & getRecomputeThreadCount();
+    static const long & defaultRecomputeThreadCount();
+    static void removeRecomputeThreadCount();
+    static void setRecomputeThreadCount(const long &v);
+    static const char *docRecomputeThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter ParallelSave
+    ///
+    /// Compress the document files concurrently in worker threads when saving.
+    /// The files are still serialized and written in order, so the resulting
+    /// archive is unchanged.
+    static const bool & getParallelSave();
+    static const bool & defaultParallelSave();
+    static void removeParallelSave();
+    static void setParallelSave(const bool &v);
+    static const char *docParallelSave();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter SaveThreadCount
+    ///
+    /// Maximum number of worker threads used by parallel save. Zero means
+    /// using the ideal thread count of the machine.
+    static const long & getSaveThreadCount();
+    static const long & defaultSaveThreadCount();
+    static void removeSaveThreadCount();
+    static void setSaveThreadCount(const long &v);
+    static const char *docSaveThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter SaveMaxPendingSize
+    ///
+    /// Maximum size in MB of serialized document files waiting to be compressed
+    /// and written during parallel save.
+    static const long & getSaveMaxPendingSize();
+    static const long & defaultSaveMaxPendingSize();
+    static void removeSaveMaxPendingSize();
+    static void setSaveMaxPendingSize(const long &v);
+    static const char *docSaveMaxPendingSize();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter ParallelRestore
+    ///
+    /// Decode the document files concurrently in worker threads when restoring.
+    /// Only files of properties that support thread safe decoding are dispatched
+    /// to the workers, e.g. Part shapes.
+    static const bool & getParallelRestore();
+    static const bool & defaultParallelRestore();
+    static void removeParallelRestore();
+    static void setParallelRestore(const bool &v);
+    static const char *docParallelRestore();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter RestoreThreadCount
+    ///
+    /// Maximum number of worker threads used by parallel restore. Zero means
+    /// using the ideal thread count of the machine.
+    static const long & getRestoreThreadCount();
+    static const long & defaultRestoreThreadCount();
+    static void removeRestoreThreadCount();
+    static void setRestoreThreadCount(const long &v);
+    static const char *docRestoreThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter IncrementalSave
+    ///
+    /// Copy the compressed files of unchanged properties from the previously saved
+    /// or restored archive instead of serializing them again. Requires the backup
+    /// policy, because the new archive is written into a temporary file first.
+    static const bool & getIncrementalSave();
+    static const bool & defaultIncrementalSave();
+    static void removeIncrementalSave();
+    static void setIncrementalSave(const bool &v);
+    static const char *docIncrementalSave();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter CompileExpressions
+    ///
+    /// Evaluate the arithmetic part of property expressions natively without going
+    /// through Python. Expressions using other constructs are still evaluated with
+    /// Python where needed.
+    static const bool & getCompileExpressions();
+    static const bool & defaultCompileExpressions();
+    static void removeCompileExpressions();
+    static void setCompileExpressions(const bool &v);
+    static const char *docCompileExpressions();
+    //@}
+
 // Auto generated code (Tools/params_utils.py:150)
 }; // class DocumentParams
 } // namespace App
@@ -68,6 +68,38 @@ Params = [
         doc='Enable special encoding of indexes name in toponaming. Disabled by\n'
             'default for backward compatibility'),
     ParamBool('EnableMaterialEdit', True),
+    ParamBool('ParallelRecompute', False,
+        doc='Recompute independent objects concurrently in worker threads. Only objects\n'
+            'that declare thread safe recompute are dispatched to the workers, e.g. the\n'
+            'shape features of the Part workbench.'),
+    ParamInt('RecomputeThreadCount', 0,
+        doc='Maximum number of worker threads used by parallel recompute. Zero means\n'
+            'using the ideal thread count of the machine.'),
+    ParamBool('ParallelSave', False,
+        doc='Compress the document files concurrently in worker threads when saving.\n'
+            'The files are still serialized and written in order, so the resulting\n'
+            'archive is unchanged.'),
+    ParamInt('SaveThreadCount', 0,
+        doc='Maximum number of worker threads used by parallel save. Zero means\n'
+            'using the ideal thread count of the machine.'),
+    ParamInt('SaveMaxPendingSize', 256,
+        doc='Maximum size in MB of serialized document files waiting to be compressed\n'
+            'and written during parallel save.'),
+    ParamBool('ParallelRestore', False,
+        doc='Decode the document files concurrently in worker threads when restoring.\n'
+            'Only files of properties that support thread safe decoding are dispatched\n'
+            'to the workers, e.g. Part shapes.'),
+    ParamInt('RestoreThreadCount', 0,
+        doc='Maximum number of worker threads used by parallel restore. Zero means\n'
+            'using the ideal thread count of the machine.'),
+    ParamBool('IncrementalSave', False,
+        doc='Copy the compressed files of unchanged properties from the previously saved\n'
+            'or restored archive instead of serializing them again. Requires the backup\n'
+            'policy, because the new archive is written into a temporary file first.'),
+    ParamBool('CompileExpressions', True,
+        doc='Evaluate the arithmetic part of property expressions natively without going\n'
+            'through Python. Expressions using other constructs are still evaluated with\n'
+            'Python where needed.'),
 ]
 
 def declare():
@@ -31,6 +31,7 @@
 #include "DocumentObject.h"
 #include "DocumentObjectPy.h"
 #include "MergeDocuments.h"
+#include "RecomputeProfiler.h"
 
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
@@ -562,6 +563,112 @@ PyObject*  DocumentPy::recompute(PyObject * args)
     } PY_CATCH;
 }
 
+PyObject* DocumentPy::memoryReport(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return nullptr;
+
+    PY_TRY {
+        auto report = getDocumentPtr()->getMemoryReport();
+
+        auto toDict = [](const std::map<std::string, std::size_t> &sizes) {
+            Py::Dict dict;
+            for (const auto &v : sizes)
+                dict.setItem(v.first, Py::Long(static_cast<unsigned long>(v.second)));
+            return dict;
+        };
+
+        std::vector<std::pair<const std::string*, const Document::MemoryReport::ObjectInfo*>> objects;
+        for (const auto &v : report.objects)
+            objects.emplace_back(&v.first, &v.second);
+        std::stable_sort(objects.begin(), objects.end(), [](const auto &a, const auto &b) {
+            return a.second->total > b.second->total;
+        });
+
+        Py::List list;
+        for (const auto &v : objects) {
+            Py::Dict dict;
+            dict.setItem("Name", Py::String(*v.first));
+            if (auto obj = getDocumentPtr()->getObject(v.first->c_str()))
+                dict.setItem("Label", Py::String(obj->Label.getStrValue()));
+            dict.setItem("Total", Py::Long(static_cast<unsigned long>(v.second->total)));
+            dict.setItem("Categories", toDict(v.second->categories));
+            dict.setItem("Properties", toDict(v.second->properties));
+            list.append(dict);
+        }
+
+        Py::Dict dict;
+        dict.setItem("Total", Py::Long(static_cast<unsigned long>(report.total)));
+        dict.setItem("Categories", toDict(report.categories));
+        dict.setItem("Objects", list);
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
+PyObject* DocumentPy::recomputeProfile(PyObject * args)
+{
+    PyObject *pyobjs = Py_None;
+    PyObject *force = Py_False;
+    const char *trace = nullptr;
+    if (!PyArg_ParseTuple(args, "|OO!z",&pyobjs,&PyBool_Type,&force,&trace))
+        return nullptr;
+
+    PY_TRY {
+        std::vector<App::DocumentObject *> objs;
+        if (pyobjs!=Py_None) {
+            if (!PySequence_Check(pyobjs)) {
+                PyErr_SetString(PyExc_TypeError, "expect input of sequence of document objects");
+                return nullptr;
+            }
+
+            Py::Sequence seq(pyobjs);
+            for (Py_ssize_t i=0;i<seq.size();++i) {
+                if (!PyObject_TypeCheck(seq[i].ptr(), &DocumentObjectPy::Type)) {
+                    PyErr_SetString(PyExc_TypeError, "Expect element in sequence to be of type document object");
+                    return nullptr;
+                }
+                objs.push_back(static_cast<DocumentObjectPy*>(seq[i].ptr())->getDocumentObjectPtr());
+            }
+        }
+
+        std::vector<RecomputeProfiler::Event> events;
+        RecomputeProfiler::start();
+        try {
+            getDocumentPtr()->recompute(objs, Base::asBoolean(force));
+        } catch (...) {
+            RecomputeProfiler::stop();
+            throw;
+        }
+        events = RecomputeProfiler::stop();
+
+        if (PyErr_Occurred())
+            return nullptr;
+
+        if (trace) {
+            Base::FileInfo fi(trace);
+            Base::ofstream str(fi, std::ios::out | std::ios::binary);
+            if (!str)
+                throw Py::RuntimeError(std::string("Failed to open trace file ") + trace);
+            RecomputeProfiler::writeChromeTrace(str, events);
+        }
+
+        Py::List res;
+        for (const auto &stats : RecomputeProfiler::summarize(events)) {
+            Py::Dict dict;
+            dict.setItem("Object", Py::String(stats.object));
+            dict.setItem("Count", Py::Long(stats.count));
+            dict.setItem("WallTime", Py::Float(stats.wallTime));
+            dict.setItem("CpuTime", Py::Float(stats.cpuTime));
+            Py::Dict categories;
+            for (const auto &v : stats.categoryTime)
+                categories.setItem(v.first, Py::Float(v.second));
+            dict.setItem("Categories", categories);
+            res.append(dict);
+        }
+        return Py::new_reference_to(res);
+    } PY_CATCH;
+}
+
 PyObject* DocumentPy::mustExecute(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -622,12 +729,8 @@ PyObject*  DocumentPy::getObjectsByLabel(PyObject *args)
         return nullptr;
 
     Py::List list;
-    std::string name = sName;
-    std::vector<DocumentObject*> objs = getDocumentPtr()->getObjects();
-    for (std::vector<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it) {
-        if (name == (*it)->Label.getValue())
-            list.append(Py::asObject((*it)->getPyObject()));
-    }
+    for (auto obj : getDocumentPtr()->getObjectsByLabel(sName))
+        list.append(Py::asObject(obj->getPyObject()));
 
     return Py::new_reference_to(list);
 }
@@ -737,6 +840,24 @@ Py::Int DocumentPy::getUndoRedoMemSize() const
     return Py::Int((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Int DocumentPy::getReusedFileCount() const
+{
+    return Py::Int(getDocumentPtr()->getReusedFileCount());
+}
+
+Py::Int DocumentPy::getUndoLimit() const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoLimit());
+}
+
+void DocumentPy::setUndoLimit(Py::Int arg)
+{
+    long limit = arg;
+    if (limit < 0)
+        throw Py::ValueError("Expect a non-negative limit");
+    getDocumentPtr()->setUndoLimit(static_cast<unsigned int>(limit));
+}
+
 Py::Int DocumentPy::getUndoCount() const
 {
     return Py::Int((long)getDocumentPtr()->getAvailableUndos());
@@ -933,6 +1054,56 @@ PyObject *DocumentPy::getDependentDocuments(PyObject *args) {
     } PY_CATCH;
 }
 
+PyObject *DocumentPy::getDependencyGraphStats(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return nullptr;
+    const auto &stats = getDocumentPtr()->getDependencyGraphStats();
+    Py::Dict dict;
+    dict.setItem("RebuildCount", Py::Long(stats.rebuildCount));
+    dict.setItem("ReuseCount", Py::Long(stats.reuseCount));
+    dict.setItem("RebuildTime", Py::Float(stats.rebuildTime));
+    dict.setItem("LastRebuildTime", Py::Float(stats.lastRebuildTime));
+    dict.setItem("LastExtractTime", Py::Float(stats.lastExtractTime));
+    dict.setItem("GraphSize", Py::Long(static_cast<long>(stats.graphSize)));
+    dict.setItem("LastSubGraphSize", Py::Long(static_cast<long>(stats.lastSubGraphSize)));
+    return Py::new_reference_to(dict);
+}
+
+PyObject *DocumentPy::openChangeBatch(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return nullptr;
+    getDocumentPtr()->openChangeBatch();
+    Py_Return;
+}
+
+PyObject *DocumentPy::closeChangeBatch(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return nullptr;
+    PY_TRY {
+        getDocumentPtr()->closeChangeBatch();
+        Py_Return;
+    } PY_CATCH;
+}
+
+PyObject *DocumentPy::getChangeNotificationStats(PyObject *args)
+{
+    PyObject *reset = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &reset))
+        return nullptr;
+    const auto &stats = getDocumentPtr()->getChangeNotificationStats();
+    Py::Dict dict;
+    dict.setItem("ChangeCount", Py::Long(stats.changeCount));
+    dict.setItem("SignalCount", Py::Long(stats.signalCount));
+    dict.setItem("CoalescedCount", Py::Long(stats.coalescedCount));
+    dict.setItem("BatchCount", Py::Long(stats.batchCount));
+    if (PyObject_IsTrue(reset))
+        getDocumentPtr()->resetChangeNotificationStats();
+    return Py::new_reference_to(dict);
+}
+
 PyObject* DocumentPy::reorderObjects(PyObject *args)
 {
     PyObject *pyobj;
@@ -57,6 +57,7 @@
 #include <Base/Tools.h>
 #include <Base/Unit.h>
 #include <Base/VectorPy.h>
+#include "DocumentParams.h"
 #include "ExpressionParser.h"
 #include "ExpressionVisitors.h"
 #include "ExpressionPy.h"
@@ -1342,6 +1343,66 @@ struct EvalFrame {
     }
 };
 
+//
+// ExpressionProgram class
+//
+// The arithmetic part of an expression, i.e. numbers, units, references to
+// numeric properties, the arithmetic operators and the math functions, is
+// flattened into an array of instructions in postfix order, and evaluated
+// without Python. Any other node is kept as a single instruction evaluating
+// the node with getPyValue(). Operations the native evaluation does not
+// handle the same way as Python (e.g. unit mismatch, division by zero,
+// integer overflow) are handed over to the Python operators, so that both
+// the result and the error are the same as evaluating with Python.
+//
+
+namespace App {
+
+class ExpressionProgram {
+public:
+    static std::unique_ptr<ExpressionProgram> compile(const Expression *expr);
+
+    /** Evaluate the program
+     *
+     * @param res: returns the result
+     * @param usePython: whether Python can be used. The caller must hold the
+     *                   GIL if true.
+     *
+     * @return Return false if Python is required but not allowed.
+     */
+    bool evaluate(App::any &res, bool usePython) const;
+
+private:
+    enum OpCode {
+        OpNumber,
+        OpVariable,
+        OpPython,
+        OpOperator,
+        OpFunction,
+    };
+
+    struct Instruction {
+        OpCode code;
+        const Expression *expr;
+    };
+
+    struct Value;
+    class Stack;
+
+    bool compileNode(const Expression *expr, int &depth);
+
+    static bool readVariable(const VariableExpression *expr, Value &value);
+    static bool calcNative(int op, const Value &a, const Value *b, Value &res);
+    static void calcPython(const Expression *expr, int op,
+                           const Value &a, const Value *b, Value &res);
+
+private:
+    std::vector<Instruction> instructions;
+    int maxDepth = 0;
+};
+
+} // namespace App
+
 //
 // Expression base-class
 //
@@ -1600,6 +1661,27 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
 }
 
 App::any Expression::getValueAsAny(int options) const {
+    if(!(options & OptionPythonMode)
+            && _EvalStack.empty()
+            && DocumentParams::getCompileExpressions())
+    {
+        if(auto program = getProgram()) {
+            App::any res;
+            if(program->evaluate(res,false))
+                return res;
+
+            // Some part of the expression requires Python. Evaluate again
+            // with the same call frame as getPyValue().
+            Base::PyGILStateLocker lock;
+            EvalFrame frame;
+            if(options & OptionCallFrame) {
+                frame.funcName = "<CallFrame>";
+                frame.push();
+            }
+            program->evaluate(res,true);
+            return res;
+        }
+    }
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue(options));
 }
@@ -1636,6 +1718,15 @@ Py::Object Expression::getPyValue(int options, int *jumpCode) const {
 void Expression::addComponent(ComponentPtr &&component) {
     assert(component);
     components.push_back(std::move(component));
+    programChecked = false;
+}
+
+const ExpressionProgram *Expression::getProgram() const {
+    if(!programChecked) {
+        programChecked = true;
+        program = ExpressionProgram::compile(this);
+    }
+    return program.get();
 }
 
 void Expression::visit(ExpressionVisitor &v) {
@@ -2000,6 +2091,9 @@ bool OperatorExpression::isTouched() const
     return left->isTouched() || right->isTouched();
 }
 
+static Py::Object calc(const Expression *expr, int op,
+                 Py::Object &l, const Py::Object &r, bool inplace);
+
 static Py::Object calc(const Expression *expr, int op,
                  Py::Object &l, const Expression *right, bool inplace) 
 {
@@ -2034,7 +2128,12 @@ static Py::Object calc(const Expression *expr, int op,
         Timing(operatorExpression2);
         r = right->getPyValue();
     }
+    return calc(expr,op,l,r,inplace);
+}
 
+static Py::Object calc(const Expression *expr, int op,
+                 Py::Object &l, const Py::Object &r, bool inplace)
+{
     _Timing(1,operatorExpression3);
 
     if(op==OP_AND || op==OP_OR)
@@ -3226,20 +3325,27 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         break;
     }
 
-    Py::Object e1 = args[0]->getPyValue();
-    Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
-    Py::Object e2;
-    Quantity v2;
-    if(args.size()>1) {
-        e2 = args[1]->getPyValue();
-        v2 = pyToQuantity(e2,expr,"Invalid second argument.");
-    }
-    Py::Object e3;
-    Quantity v3;
-    if(args.size()>2) {
-        e3 = args[2]->getPyValue();
-        v3 = pyToQuantity(e3,expr,"Invalid third argument.");
-    }
+    Quantity v[3];
+    int argc = std::min<int>(3, args.size());
+    v[0] = pyToQuantity(args[0]->getPyValue(),expr,"Invalid first argument.");
+    if(argc>1)
+        v[1] = pyToQuantity(args[1]->getPyValue(),expr,"Invalid second argument.");
+    if(argc>2)
+        v[2] = pyToQuantity(args[2]->getPyValue(),expr,"Invalid third argument.");
+    return Py::asObject(new QuantityPy(new Quantity(evaluate(expr,f,v,argc))));
+}
+
+/**
+  * Evaluate the math functions taking one to three quantities, i.e. the
+  * functions from ACOS to CATH. Shared by the Python and the compiled
+  * evaluation of FunctionExpression.
+  */
+
+Quantity FunctionExpression::evaluate(const Expression *expr, int f, const Quantity *args, int argc)
+{
+    const Quantity &v1 = args[0];
+    const Quantity &v2 = argc>1 ? args[1] : args[0];
+    const Quantity &v3 = argc>2 ? args[2] : args[0];
 
     double output;
     Unit unit;
@@ -3310,7 +3416,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (argc<2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -3319,12 +3425,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         scaler = 180.0 / M_PI;
         break;
     case FMOD:
-        if (e2.isNone())
+        if (argc<2)
             _EXPR_THROW("Invalid second argument.",expr);
         unit = v1.getUnit() / v2.getUnit();
         break;
     case FPOW: {
-        if (e2.isNone())
+        if (argc<2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.getUnit().isEmpty())
@@ -3342,14 +3448,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argc<2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
+        if (argc > 2) {
             if (v2.getUnit() != v3.getUnit())
                 _EXPR_THROW("Units must be equal.",expr);
         }
@@ -3416,11 +3520,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (argc>2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (argc>2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -3439,7 +3543,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const Exp
         _EXPR_THROW("Unknown function: " << f,0);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue(int *) const {
@@ -7010,6 +7114,522 @@ Py::Object FromStatement::_getPyValue(int *) const {
 
 ////////////////////////////////////////////////////////////////////////////////////
 
+struct ExpressionProgram::Value {
+    enum Type {
+        TypeInt,
+        TypeFloat,
+        TypeQuantity,
+        TypeObject,
+    };
+    Type type = TypeInt;
+    long l = 0;
+    double d = 0.0;
+    Quantity q;
+    // Owned reference, only set when evaluating with Python
+    PyObject *obj = nullptr;
+
+    Value() = default;
+    Value(const Value &) = delete;
+    Value &operator=(const Value &) = delete;
+
+    Value(Value &&other) {
+        *this = std::move(other);
+    }
+
+    Value &operator=(Value &&other) {
+        if(this != &other) {
+            clear();
+            type = other.type;
+            l = other.l;
+            d = other.d;
+            q = other.q;
+            obj = other.obj;
+            other.obj = nullptr;
+        }
+        return *this;
+    }
+
+    ~Value() {
+        clear();
+    }
+
+    void clear() {
+        if(obj) {
+            Py_DECREF(obj);
+            obj = nullptr;
+        }
+    }
+
+    void setInt(long v) {
+        clear();
+        type = TypeInt;
+        l = v;
+    }
+
+    void setFloat(double v) {
+        clear();
+        type = TypeFloat;
+        d = v;
+    }
+
+    void setQuantity(const Quantity &v) {
+        clear();
+        type = TypeQuantity;
+        q = v;
+    }
+
+    /// Same conversion as pyFromQuantity()
+    void setNumber(const Quantity &v) {
+        if(!v.getUnit().isEmpty()) {
+            setQuantity(v);
+            return;
+        }
+        long lv;
+        int iv;
+        switch(essentiallyInteger(v.getValue(),lv,iv)) {
+        case 1:
+        case 2:
+            setInt(lv);
+            break;
+        default:
+            setFloat(v.getValue());
+        }
+    }
+
+    void setPyObject(const Py::Object &pyobj) {
+        PyObject *p = pyobj.ptr();
+        if(PyObject_TypeCheck(p,&QuantityPy::Type)) {
+            setQuantity(*static_cast<QuantityPy*>(p)->getQuantityPtr());
+            return;
+        }
+        if(PyFloat_CheckExact(p)) {
+            setFloat(PyFloat_AS_DOUBLE(p));
+            return;
+        }
+        if(PyLong_CheckExact(p)) {
+            int overflow = 0;
+            long v = PyLong_AsLongAndOverflow(p,&overflow);
+            if(!overflow && !(v == -1 && PyErr_Occurred())) {
+                setInt(v);
+                return;
+            }
+            PyErr_Clear();
+        }
+        clear();
+        type = TypeObject;
+        obj = Py::new_reference_to(pyobj);
+    }
+
+    Py::Object getPyObject() const {
+        switch(type) {
+        case TypeInt:
+            return Py::Long(l);
+        case TypeFloat:
+            return Py::Float(d);
+        case TypeQuantity:
+            return Py::asObject(new QuantityPy(new Quantity(q)));
+        default:
+            return Py::Object(obj);
+        }
+    }
+
+    double getDouble() const {
+        return type == TypeInt ? static_cast<double>(l) : d;
+    }
+
+    Quantity getQuantity() const {
+        switch(type) {
+        case TypeInt:
+            return Quantity(l);
+        case TypeFloat:
+            return Quantity(d);
+        default:
+            return q;
+        }
+    }
+};
+
+class ExpressionProgram::Stack {
+public:
+    explicit Stack(int size) {
+        values.reserve(size);
+    }
+
+    Value &push() {
+        values.emplace_back();
+        return values.back();
+    }
+
+    void pop(int count=1) {
+        values.resize(values.size() - count);
+    }
+
+    Value &top(int index=0) {
+        return values[values.size() - 1 - index];
+    }
+
+    std::vector<Value> values;
+};
+
+std::unique_ptr<ExpressionProgram> ExpressionProgram::compile(const Expression *expr)
+{
+    std::unique_ptr<ExpressionProgram> program(new ExpressionProgram);
+    int depth = 0;
+    // No point to compile if the whole expression requires Python
+    if(!program->compileNode(expr,depth))
+        return nullptr;
+    return program;
+}
+
+bool ExpressionProgram::compileNode(const Expression *expr, int &depth)
+{
+    OpCode code = OpPython;
+    if(!expr->hasComponent()) {
+        Base::Type type = expr->getTypeId();
+        if(type == NumberExpression::getClassTypeId()
+                || type == UnitExpression::getClassTypeId())
+        {
+            code = OpNumber;
+        }
+        else if(type == ConstantExpression::getClassTypeId()) {
+            if(static_cast<const ConstantExpression*>(expr)->isNumber())
+                code = OpNumber;
+        }
+        else if(type == VariableExpression::getClassTypeId()) {
+            code = OpVariable;
+        }
+        else if(type == OperatorExpression::getClassTypeId()) {
+            auto e = static_cast<const OperatorExpression*>(expr);
+            switch(e->getOperator()) {
+            case OP_NEG:
+            case OP_POS:
+                compileNode(e->getLeft(),depth);
+                instructions.push_back({OpOperator,expr});
+                return true;
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+            case OP_POW:
+            case OP_POW2:
+            case OP_UNIT:
+            case OP_UNIT_ADD:
+                compileNode(e->getLeft(),depth);
+                compileNode(e->getRight(),depth);
+                instructions.push_back({OpOperator,expr});
+                --depth;
+                return true;
+            default:
+                break;
+            }
+        }
+        else if(type == FunctionExpression::getClassTypeId()) {
+            auto e = static_cast<const FunctionExpression*>(expr);
+            const auto &args = e->getArgs();
+            if(e->getOwner()
+                    && e->type() >= FunctionExpression::ACOS
+                    && e->type() <= FunctionExpression::CATH
+                    && !args.empty()
+                    && args.size() <= 3)
+            {
+                for(auto &arg : args)
+                    compileNode(arg.get(),depth);
+                instructions.push_back({OpFunction,expr});
+                depth -= static_cast<int>(args.size()) - 1;
+                return true;
+            }
+        }
+    }
+    instructions.push_back({code,expr});
+    maxDepth = std::max(maxDepth,++depth);
+    return code != OpPython;
+}
+
+bool ExpressionProgram::readVariable(const VariableExpression *expr, Value &value)
+{
+    Property *prop;
+    try {
+        prop = expr->getPath().getWholeProperty();
+    } catch (Base::Exception &) {
+        // Let the Python evaluation report the error
+        return false;
+    }
+    if(!prop)
+        return false;
+    if(prop->isDerivedFrom(PropertyQuantity::getClassTypeId()))
+        value.setQuantity(static_cast<PropertyQuantity*>(prop)->getQuantityValue());
+    else if(prop->isDerivedFrom(PropertyFloat::getClassTypeId()))
+        value.setFloat(static_cast<PropertyFloat*>(prop)->getValue());
+    else if(prop->isDerivedFrom(PropertyInteger::getClassTypeId()))
+        value.setInt(static_cast<PropertyInteger*>(prop)->getValue());
+    else
+        return false;
+    return true;
+}
+
+static inline bool checkedAdd(long a, long b, long &res)
+{
+    if((b > 0 && a > LONG_MAX - b) || (b < 0 && a < LONG_MIN - b))
+        return false;
+    res = a + b;
+    return true;
+}
+
+static inline bool checkedMultiply(long a, long b, long &res)
+{
+    if(a > 0) {
+        if(b > 0 ? a > LONG_MAX / b : b < LONG_MIN / a)
+            return false;
+    }
+    else if(b > 0 ? a < LONG_MIN / b : (a != 0 && b < LONG_MAX / a))
+        return false;
+    res = a * b;
+    return true;
+}
+
+bool ExpressionProgram::calcNative(int op, const Value &a, const Value *b, Value &res)
+{
+    if(a.type == Value::TypeObject || (b && b->type == Value::TypeObject))
+        return false;
+
+    if(!b) {
+        if(op == OP_POS) {
+            if(a.type == Value::TypeQuantity)
+                res.setQuantity(a.q);
+            else if(a.type == Value::TypeFloat)
+                res.setFloat(a.d);
+            else
+                res.setInt(a.l);
+            return true;
+        }
+        switch(a.type) {
+        case Value::TypeQuantity:
+            // same as QuantityPy::number_negative_handler()
+            res.setQuantity(a.q * -1.0);
+            return true;
+        case Value::TypeFloat:
+            res.setFloat(-a.d);
+            return true;
+        default:
+            if(a.l == LONG_MIN)
+                return false;
+            res.setInt(-a.l);
+            return true;
+        }
+    }
+
+    if(a.type == Value::TypeQuantity || b->type == Value::TypeQuantity) {
+        try {
+            switch(op) {
+            case OP_ADD:
+            case OP_UNIT_ADD:
+                res.setQuantity(a.getQuantity() + b->getQuantity());
+                return true;
+            case OP_SUB:
+                res.setQuantity(a.getQuantity() - b->getQuantity());
+                return true;
+            case OP_MUL:
+            case OP_UNIT:
+                res.setQuantity(a.getQuantity() * b->getQuantity());
+                return true;
+            case OP_DIV:
+                res.setQuantity(a.getQuantity() / b->getQuantity());
+                return true;
+            default:
+                // Python only supports Quantity as the base of power
+                if(a.type != Value::TypeQuantity)
+                    return false;
+                if(b->type == Value::TypeQuantity)
+                    res.setQuantity(a.q.pow(b->q));
+                else
+                    res.setQuantity(a.q.pow(b->getDouble()));
+                return true;
+            }
+        } catch (Base::Exception &) {
+            return false;
+        }
+    }
+
+    if(a.type == Value::TypeInt && b->type == Value::TypeInt) {
+        long v;
+        switch(op) {
+        case OP_ADD:
+        case OP_UNIT_ADD:
+            if(!checkedAdd(a.l,b->l,v))
+                return false;
+            res.setInt(v);
+            return true;
+        case OP_SUB:
+            if(b->l == LONG_MIN || !checkedAdd(a.l,-b->l,v))
+                return false;
+            res.setInt(v);
+            return true;
+        case OP_MUL:
+        case OP_UNIT:
+            if(!checkedMultiply(a.l,b->l,v))
+                return false;
+            res.setInt(v);
+            return true;
+        case OP_DIV: {
+            // Python divides integers exactly only if they fit in a double
+            const double limit = 9007199254740992.0; // 2^53
+            if(b->l == 0
+                    || std::fabs(static_cast<double>(a.l)) > limit
+                    || std::fabs(static_cast<double>(b->l)) > limit)
+                return false;
+            res.setFloat(static_cast<double>(a.l) / static_cast<double>(b->l));
+            return true;
+        }
+        default:
+            if(b->l < 0)
+                break;
+            v = 1;
+            for(long base = a.l, exp = b->l; exp; exp >>= 1) {
+                if((exp & 1) && !checkedMultiply(v,base,v))
+                    return false;
+                if(exp > 1 && !checkedMultiply(base,base,base))
+                    return false;
+            }
+            res.setInt(v);
+            return true;
+        }
+    }
+
+    double x = a.getDouble();
+    double y = b->getDouble();
+    switch(op) {
+    case OP_ADD:
+    case OP_UNIT_ADD:
+        res.setFloat(x + y);
+        return true;
+    case OP_SUB:
+        res.setFloat(x - y);
+        return true;
+    case OP_MUL:
+    case OP_UNIT:
+        res.setFloat(x * y);
+        return true;
+    case OP_DIV:
+        if(y == 0.0)
+            return false;
+        res.setFloat(x / y);
+        return true;
+    default: {
+        // Python raises exception on zero division and overflow, and returns
+        // complex number for fractional power of negative numbers
+        if(x == 0.0 && y < 0.0)
+            return false;
+        if(x < 0.0 && std::isfinite(y) && std::floor(y) != y)
+            return false;
+        double v = std::pow(x,y);
+        if(std::isinf(v) && std::isfinite(x) && std::isfinite(y))
+            return false;
+        res.setFloat(v);
+        return true;
+    }
+    }
+}
+
+void ExpressionProgram::calcPython(const Expression *expr, int op,
+                                   const Value &a, const Value *b, Value &res)
+{
+    Py::Object l = a.getPyObject();
+    if(b)
+        res.setPyObject(calc(expr,op,l,b->getPyObject(),false));
+    else
+        res.setPyObject(calc(expr,op,l,static_cast<const Expression*>(nullptr),false));
+}
+
+bool ExpressionProgram::evaluate(App::any &res, bool usePython) const
+{
+    static const char *argErrors[] = {
+        "Invalid first argument.",
+        "Invalid second argument.",
+        "Invalid third argument.",
+    };
+
+    Stack stack(maxDepth);
+    for(auto &inst : instructions) {
+        switch(inst.code) {
+        case OpNumber:
+            stack.push().setNumber(static_cast<const UnitExpression*>(inst.expr)->getQuantity());
+            break;
+        case OpVariable: {
+            Value &value = stack.push();
+            if(readVariable(static_cast<const VariableExpression*>(inst.expr),value))
+                break;
+            if(!usePython)
+                return false;
+            value.setPyObject(inst.expr->getPyValue());
+            break;
+        }
+        case OpPython:
+            if(!usePython)
+                return false;
+            stack.push().setPyObject(inst.expr->getPyValue());
+            break;
+        case OpOperator: {
+            int op = static_cast<const OperatorExpression*>(inst.expr)->getOperator();
+            Value value;
+            if(op == OP_NEG || op == OP_POS) {
+                Value &a = stack.top();
+                if(!calcNative(op,a,nullptr,value)) {
+                    if(!usePython)
+                        return false;
+                    calcPython(inst.expr,op,a,nullptr,value);
+                }
+                a = std::move(value);
+            } else {
+                Value &a = stack.top(1);
+                Value &b = stack.top();
+                if(!calcNative(op,a,&b,value)) {
+                    if(!usePython)
+                        return false;
+                    calcPython(inst.expr,op,a,&b,value);
+                }
+                a = std::move(value);
+                stack.pop();
+            }
+            break;
+        }
+        case OpFunction: {
+            auto e = static_cast<const FunctionExpression*>(inst.expr);
+            int argc = static_cast<int>(e->getArgs().size());
+            Quantity args[3];
+            for(int i=0; i<argc; ++i) {
+                const Value &value = stack.top(argc-1-i);
+                if(value.type != Value::TypeObject)
+                    args[i] = value.getQuantity();
+                else
+                    args[i] = pyToQuantity(Py::Object(value.obj),inst.expr,argErrors[i]);
+            }
+            stack.pop(argc);
+            stack.push().setQuantity(FunctionExpression::evaluate(inst.expr,e->type(),args,argc));
+            break;
+        }
+        }
+    }
+
+    const Value &value = stack.top();
+    switch(value.type) {
+    case Value::TypeInt:
+        res = App::any(value.l);
+        break;
+    case Value::TypeFloat:
+        res = App::any(value.d);
+        break;
+    case Value::TypeQuantity:
+        res = App::any(value.q);
+        break;
+    default:
+        res = pyObjectToAny(Py::Object(value.obj));
+        break;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
 static Base::XMLReader *_Reader = nullptr;
 ExpressionParser::ExpressionImporter::ExpressionImporter(Base::XMLReader &reader) {
     assert(!_Reader);
@@ -45,6 +45,7 @@ namespace App  {
 
 class DocumentObject;
 class Expression;
+class ExpressionProgram;
 class Document;
 
 using ExpressionPtr = std::unique_ptr<Expression>;
@@ -169,6 +170,12 @@ public:
     };
     ExpressionPtr eval(int options=0) const;
 
+    /** Evaluate the expression and return the result
+     *
+     * Arithmetic over numbers, units, numeric properties and the math
+     * functions is evaluated natively without Python, using a compiled
+     * form of the expression (see DocumentParams::getCompileExpressions()).
+     */
     App::any getValueAsAny(int options=0) const;
 
     Py::Object getPyValue(int options=0, int *jumpCode=0) const;
@@ -293,7 +300,14 @@ protected:
     virtual Py::Object _getPyValue(int *jumpCode=nullptr) const = 0;
     virtual void _visit(ExpressionVisitor &) {}
 
-    void swapComponents(Expression &other) {components.swap(other.components);}
+    void swapComponents(Expression &other) {
+        components.swap(other.components);
+        programChecked = false;
+        other.programChecked = false;
+    }
+
+    /// Return the compiled form of this expression, or nullptr if it cannot be compiled
+    const ExpressionProgram *getProgram() const;
 
     friend ExpressionVisitor;
 
@@ -302,6 +316,10 @@ protected:
 
     ComponentList components;
 
+private:
+    mutable std::unique_ptr<ExpressionProgram> program;
+    mutable bool programChecked = false;
+
 public:
     std::string comment;
 };
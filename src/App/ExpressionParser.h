@@ -626,6 +626,8 @@ public:
     int type() const {return ftype;}
 
     static Py::Object evaluate(const Expression *owner, int type, const ExpressionList &args);
+    /// Evaluate a math function, i.e. ACOS to CATH, of one to three quantities
+    static Base::Quantity evaluate(const Expression *owner, int type, const Base::Quantity *args, int argc);
 
     const ExpressionList &getArgs() const {return args;}
 
@@ -323,6 +323,11 @@ public:
         return FeatureT::canLoadPartial();
     }
 
+    bool canRecomputeInThread() const override {
+        // Python feature requires GIL
+        return false;
+    }
+
     std::string getElementMapVersion(const App::Property *prop, bool restored=false) const override {
         std::string ver = FeatureT::getElementMapVersion(prop, restored);
         imp->getElementMapVersion(ver, prop, restored);
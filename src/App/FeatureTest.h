@@ -108,6 +108,10 @@ public:
   short mustExecute() const override;
   /// recalculate the Feature
   DocumentObjectExecReturn *execute() override;
+  /// allow testing parallel recompute
+  bool canRecomputeInThread() const override {
+    return true;
+  }
   /// returns the type name of the ViewProvider
   //Hint: Probably it makes sense to have a view provider for unittests (e.g. Gui::ViewProviderTest)
   const char* getViewProviderName() const override {
@@ -685,6 +685,34 @@ class FCADLogger(object):
 
 FreeCAD.Logger = FCADLogger
 
+class ChangeBatch(object):
+    '''Context manager to batch the change notifications of a document.
+
+       Inside the context, the observers of the document are notified once
+       per changed property, when the context exits, instead of on every
+       change. The objects still handle their own changes immediately.
+
+       Example usage:
+           >>> with FreeCAD.ChangeBatch(doc):
+           ...     for i, obj in enumerate(doc.Objects):
+           ...         obj.Label = 'Part%d' % i
+    '''
+
+    def __init__(self, doc=None):
+        self.doc = doc if doc else FreeCAD.ActiveDocument
+        if not self.doc:
+            raise ValueError('No document')
+
+    def __enter__(self):
+        self.doc.openChangeBatch()
+        return self
+
+    def __exit__(self, exc_type, exc_value, tb):
+        self.doc.closeChangeBatch()
+        return False
+
+FreeCAD.ChangeBatch = ChangeBatch
+
 # init every application by importing Init.py
 try:
     InitApplications()
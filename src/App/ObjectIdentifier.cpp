@@ -1006,16 +1006,14 @@ App::DocumentObject * ObjectIdentifier::getDocumentObject(const App::Document *
             return nullptr;
     }
 
-    std::vector<DocumentObject*> docObjects = doc->getObjects();
-    for (std::vector<DocumentObject*>::iterator j = docObjects.begin(); j != docObjects.end(); ++j) {
-        if (strcmp((*j)->Label.getValue(), static_cast<const char*>(name)) == 0) {
-            // Found object with matching label
-            if (objectByLabel)  {
-                FC_WARN("duplicate object label " << doc->getName() << '#' << static_cast<const char*>(name));
-                return nullptr;
-            }
-            objectByLabel = *j;
-        }
+    auto objectsByLabel = doc->getObjectsByLabel(static_cast<const char*>(name));
+    if (objectsByLabel.size() > 1) {
+        FC_WARN("duplicate object label " << doc->getName() << '#' << static_cast<const char*>(name));
+        return nullptr;
+    }
+    if (!objectsByLabel.empty()) {
+        // Found object with matching label
+        objectByLabel = objectsByLabel.front();
     }
 
     if (!objectByLabel && !objectById) // Not found at all
@@ -1593,6 +1591,19 @@ Property *ObjectIdentifier::getProperty(int *ptype) const
     return result.resolvedProperty;
 }
 
+Property *ObjectIdentifier::getWholeProperty() const
+{
+    ResolveResults result(*this);
+    if (!result.resolvedDocumentObject
+            || !result.resolvedProperty
+            || result.propertyType != PseudoNone
+            || (!subObjectName.getString().empty() && !result.resolvedSubObject)
+            || result.propertyIndex + 1 != (int)components.size()
+            || !components[result.propertyIndex].isSimple())
+        return nullptr;
+    return result.resolvedProperty;
+}
+
 const std::vector<std::pair<const char *, App::Property*> > &ObjectIdentifier::getPseudoProperties()
 {
     static PropertyContainer dummy;
@@ -351,6 +351,14 @@ public:
 
     App::Property *getProperty(int *ptype=nullptr) const;
 
+    /** Return the property if this identifier references a whole property
+     *
+     * @return The property, or nullptr if the identifier does not resolve,
+     * resolves to a pseudo property, or references some path inside the
+     * property.
+     */
+    App::Property *getWholeProperty() const;
+
     App::ObjectIdentifier canonicalPath() const;
 
     // Document-centric functions
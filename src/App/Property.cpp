@@ -267,6 +267,7 @@ void Property::touch()
 
     PropertyCleaner guard(this);
     _StatusBits.set(Touched);
+    _StatusBits.reset(Saved);
     if (getName() && father
                   && !Transaction::isApplying(this)
                   && !Document::isRemoving(this)) {
@@ -355,6 +356,7 @@ void Property::setStatusValue(unsigned long status) {
         |(1<<PropOutput)
         |(1<<PropHidden)
         |(1<<PropNoPersist)
+        |(1<<Saved)
         |(1<<Busy);
 
     status &= ~mask;
@@ -377,6 +379,11 @@ void Property::setStatus(Status pos, bool on) {
             purgeTouched();
         return;
     }
+    if(pos == Saved) {
+        // Not settable through setStatusValue() so that it is never restored
+        _StatusBits.set(Saved, on);
+        return;
+    }
     auto bits = _StatusBits;
     bits.set(pos,on);
     setStatusValue(bits.to_ulong());
@@ -399,6 +406,11 @@ bool Property::testStatus(const StatusBits &bits, const StatusBits &mask) const
     return (copy & bits) == bits;
 }
 
+void Property::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    sizes["Property"] += getMemSize();
+}
+
 bool Property::isSameContent(const Property &other) const {
     if(&other == this)
         return true;
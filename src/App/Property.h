@@ -34,12 +34,13 @@
 #endif
 #include <boost/signals2.hpp>
 #include <bitset>
+#include <map>
 #include <string>
 #include <FCGlobal.h>
 
-// WARNING! define this to static thread_local if FreeCAD ever decides to use
-// multi-threading recomputation.
-#define FC_STATIC static
+// Scratch buffers that would have been plain static. They must be thread local
+// because of parallel recomputation (see DocumentParams::getParallelRecompute()).
+#define FC_STATIC static thread_local
 
 namespace Py {
 class Object;
@@ -87,6 +88,7 @@ public:
         Busy = 15, // internal use to avoid recursive signaling
         CopyOnChange = 16, // for Link to copy the linked object on change of the property with this flag
         UserEdit = 17, // cause property editor to create button for user defined editing
+        Saved = 18, // internal use to mark the property unchanged since last save or restore
 
         // The following bits are corresponding to PropertyType set when the
         // property added. These types are meant to be static, and cannot be
@@ -128,6 +130,14 @@ public:
         return sizeof(father) + sizeof(StatusBits);
     }
 
+    /** Add the memory used by this property to \a sizes, split by category
+     *
+     * Properties holding large data, e.g. geometry, report it under categories
+     * like "BRep", "Triangulation" or "ElementMap". The default implementation
+     * adds getMemSize() to the category "Property".
+     */
+    virtual void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const;
+
     /** Get the name of this property in the belonging container
      * With \ref hasName() it can be checked beforehand if a valid name is set.
      * @note If no name is set this function returns an empty string, i.e. "".
@@ -257,6 +267,14 @@ public:
 
     /// Returns a new copy of the property (mainly for Undo/Redo and transactions)
     virtual Property *Copy() const = 0;
+    /** Returns an identifier of the data shared with the copies of this property
+     *
+     * Properties holding large geometry may let Copy() reference the same
+     * immutable data instead of duplicating it. The returned identifier is
+     * used to count such data only once in the memory usage of the undo
+     * stack. Returns nullptr if the data is not shared.
+     */
+    virtual const void *getSharedData() const { return nullptr; }
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
 
@@ -338,7 +338,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
     for(auto prop : transients) {
         writer.Stream() << writer.ind() << "<_Property name=\"" << prop->getName() 
             << "\" type=\"" << prop->getTypeId().getName() 
-            << "\" status=\"" << prop->getStatus() << "\"/>\n";
+            << "\" status=\"" << (prop->getStatus() & ~(1ul<<Property::Saved)) << "\"/>\n";
     }
     writer.decInd();
 
@@ -351,7 +351,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
 
         dynamicProps.save(it->second,writer);
 
-        auto status = it->second->getStatus();
+        auto status = it->second->getStatus() & ~(1ul<<Property::Saved);
         if(status)
             writer.Stream() << "\" status=\"" << status;
         writer.Stream() << "\">";
@@ -368,6 +368,8 @@ void PropertyContainer::Save (Base::Writer &writer) const
 
         writer.incInd(); // indentation for the actual property
 
+        // Record the property as the owner of any file added during saving
+        auto fileOwner = writer.setFileOwner(it->second);
         try {
             // We must make sure to handle all exceptions accordingly so that
             // the project file doesn't get invalidated. In the error case this
@@ -388,6 +390,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
             Base::Console().Error("PropertyContainer::Save: Unknown C++ exception thrown. Try to continue...\n");
         }
 #endif
+        writer.setFileOwner(fileOwner);
         writer.decInd(); // indentation for the actual property
         writer.Stream() << writer.ind() << "</Property>\n";    
         writer.decInd(); // indentation for 'Property name'
@@ -455,7 +458,14 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
                         && !prop->testStatus(Property::PropTransient))
                 {
                     FC_TRACE("restoring property " << prop->getFullName());
-                    prop->Restore(reader);
+                    auto fileOwner = reader.setFileOwner(prop);
+                    try {
+                        prop->Restore(reader);
+                    } catch (...) {
+                        reader.setFileOwner(fileOwner);
+                        throw;
+                    }
+                    reader.setFileOwner(fileOwner);
                 }else
                     FC_TRACE("skip transient " << prop->getFullName());
             }
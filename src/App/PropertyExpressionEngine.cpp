@@ -38,6 +38,7 @@
 #include "PropertyUnits.h"
 #include "ExpressionParser.h"
 #include "ExpressionVisitors.h"
+#include "RecomputeProfiler.h"
 
 FC_LOG_LEVEL_INIT("App", true);
 
@@ -695,6 +696,8 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
     if (running)
         return DocumentObject::StdReturn;
 
+    RecomputeProfiler::Scope profileScope("expression", "ExpressionEngine", docObj);
+
     if(option == ExecuteOnRestore) {
         bool found = false;
         for(auto &e : expressions) {
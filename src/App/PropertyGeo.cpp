@@ -1524,6 +1524,12 @@ bool PropertyComplexGeoData::isSame(const Property &_other) const
     return data->isSame(*other);
 }
 
+void PropertyComplexGeoData::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    if (auto data = getComplexData())
+        data->getMemSizeDetails(sizes);
+}
+
 void PropertyComplexGeoData::afterRestore()
 {
     auto data = getComplexData();
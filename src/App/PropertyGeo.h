@@ -625,6 +625,7 @@ public:
 
     bool isSame(const Property &other) const override;
     Property *copyBeforeChange() const override {return Copy();}
+    void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const override;
 
     void afterRestore() override;
 };
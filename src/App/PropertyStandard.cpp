@@ -1556,21 +1556,21 @@ void PropertyString::setValue(const char* newLabel)
 
         App::Document* doc = obj->getDocument();
         if(doc && !DocumentParams::getDuplicateLabels() && !obj->allowDuplicateLabel()) {
-            std::vector<std::string> objectLabels;
-            std::vector<App::DocumentObject*>::const_iterator it;
-            std::vector<App::DocumentObject*> objs = doc->getObjects();
             bool match = false;
-            for (it = objs.begin();it != objs.end();++it) {
-                if (*it == obj)
-                    continue; // don't compare object with itself
-                std::string objLabel = (*it)->Label.getValue();
-                if (!match && objLabel == newLabel)
+            for (auto o : doc->getObjectsByLabel(newLabel)) {
+                if (o != obj) { // don't compare object with itself
                     match = true;
-                objectLabels.push_back(objLabel);
+                    break;
+                }
             }
 
             // make sure that there is a name conflict otherwise we don't have to do anything
             if (match && *newLabel) {
+                std::vector<std::string> objectLabels;
+                for (auto o : doc->getObjects()) {
+                    if (o != obj)
+                        objectLabels.push_back(o->Label.getValue());
+                }
                 label = newLabel;
                 // remove number from end to avoid lengthy names
                 size_t lastpos = label.length()-1;
@@ -0,0 +1,237 @@
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>       *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <chrono>
+# include <cstring>
+# include <ctime>
+# include <mutex>
+# include <ostream>
+# ifdef FC_OS_WIN32
+#  include <windows.h>
+# endif
+#endif
+
+#include "RecomputeProfiler.h"
+#include "DocumentObject.h"
+
+using namespace App;
+
+std::atomic<bool> RecomputeProfiler::_active;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct ThreadState {
+    int id = 0;
+    // events of the open scopes of this thread
+    std::vector<const RecomputeProfiler::Event*> scopes;
+};
+
+thread_local ThreadState _ThreadState;
+std::atomic<int> _ThreadCounter;
+std::atomic<long> _Generation;
+std::atomic<Clock::rep> _StartTime;
+std::mutex _Mutex;
+std::vector<RecomputeProfiler::Event> _Events;
+
+double elapsedTime()
+{
+    Clock::duration d(Clock::now().time_since_epoch().count() - _StartTime.load());
+    return std::chrono::duration<double>(d).count();
+}
+
+double threadCpuTime()
+{
+#if defined(FC_OS_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return 0.0;
+    auto toSeconds = [](const FILETIME &t) {
+        return (double(t.dwHighDateTime) * 4294967296.0 + t.dwLowDateTime) * 1e-7;
+    };
+    return toSeconds(kernel) + toSeconds(user);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0.0;
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return double(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+void writeJsonString(std::ostream &out, const std::string &s)
+{
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (unsigned char c : s) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (c < 0x20)
+                out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+            else
+                out << c;
+        }
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+void RecomputeProfiler::start()
+{
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Events.clear();
+    ++_Generation;
+    _StartTime = Clock::now().time_since_epoch().count();
+    _active.store(true, std::memory_order_release);
+}
+
+std::vector<RecomputeProfiler::Event> RecomputeProfiler::stop()
+{
+    _active.store(false);
+    std::lock_guard<std::mutex> lock(_Mutex);
+    ++_Generation;
+    std::vector<Event> events;
+    events.swap(_Events);
+    return events;
+}
+
+void RecomputeProfiler::Scope::begin(const char *category, const char *name,
+                                     const DocumentObject *obj)
+{
+    if (!_active.load(std::memory_order_acquire))
+        return;
+
+    auto &state = _ThreadState;
+    if (!state.id)
+        state.id = ++_ThreadCounter;
+
+    event.category = category;
+    if (obj && obj->getNameInDocument())
+        event.object = obj->getFullName();
+    else if (!state.scopes.empty())
+        event.object = state.scopes.back()->object;
+    event.name = name ? name : event.object;
+    event.thread = state.id;
+    event.depth = static_cast<int>(state.scopes.size());
+    for (auto parent : state.scopes) {
+        if (parent->object == event.object && std::strcmp(parent->category, category) == 0) {
+            event.recursive = true;
+            break;
+        }
+    }
+    state.scopes.push_back(&event);
+
+    generation = _Generation.load();
+    active = true;
+    event.cpuTime = threadCpuTime();
+    event.start = elapsedTime();
+}
+
+void RecomputeProfiler::Scope::end()
+{
+    double now = elapsedTime();
+    double cpuTime = threadCpuTime();
+
+    auto &scopes = _ThreadState.scopes;
+    auto it = std::find(scopes.rbegin(), scopes.rend(), &event);
+    if (it != scopes.rend())
+        scopes.erase(std::next(it).base());
+
+    event.duration = now - event.start;
+    event.cpuTime = cpuTime - event.cpuTime;
+
+    std::lock_guard<std::mutex> lock(_Mutex);
+    if (generation == _Generation.load() && isActive())
+        _Events.push_back(std::move(event));
+}
+
+std::vector<RecomputeProfiler::ObjectStats>
+RecomputeProfiler::summarize(const std::vector<Event> &events)
+{
+    std::map<std::string, ObjectStats> statMap;
+    for (const auto &event : events) {
+        if (event.object.empty())
+            continue;
+        auto &stats = statMap[event.object];
+        if (!event.recursive)
+            stats.categoryTime[event.category] += event.duration;
+        if (std::strcmp(event.category, "recompute") == 0) {
+            ++stats.count;
+            stats.wallTime += event.duration;
+            stats.cpuTime += event.cpuTime;
+        }
+    }
+
+    std::vector<ObjectStats> res;
+    res.reserve(statMap.size());
+    for (auto &v : statMap) {
+        v.second.object = v.first;
+        res.push_back(std::move(v.second));
+    }
+    std::stable_sort(res.begin(), res.end(), [](const ObjectStats &a, const ObjectStats &b) {
+        return a.wallTime > b.wallTime;
+    });
+    return res;
+}
+
+void RecomputeProfiler::writeChromeTrace(std::ostream &out, const std::vector<Event> &events)
+{
+    std::ios::fmtflags flags = out.flags();
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto &event : events) {
+        if (!first)
+            out << ',';
+        first = false;
+        out << "\n{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"cat\":";
+        writeJsonString(out, event.category);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << std::fixed << event.start * 1e6
+            << ",\"dur\":" << event.duration * 1e6
+            << ",\"args\":{\"object\":";
+        writeJsonString(out, event.object);
+        out << ",\"cpu\":" << event.cpuTime * 1e6 << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    out.flags(flags);
+}
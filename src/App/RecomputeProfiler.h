@@ -0,0 +1,132 @@
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>       *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#ifndef APP_RECOMPUTEPROFILER_H
+#define APP_RECOMPUTEPROFILER_H
+
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+#include <FCGlobal.h>
+
+namespace App
+{
+
+class DocumentObject;
+
+/** Profiler of document recomputation
+ *
+ * While the profiler is active, each RecomputeProfiler::Scope placed in the
+ * recompute code path records its wall time, the CPU time of its thread, and
+ * the object it works on. A scope without object is attributed to the object
+ * of the enclosing scope in the same thread. The recorded events can be
+ * summarized per object, or written as Chrome trace JSON to be viewed in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Scopes cost one atomic load when the profiler is not active.
+ */
+class AppExport RecomputeProfiler
+{
+public:
+    /// A recorded scope
+    struct Event {
+        /// category of the scope, e.g. "recompute", "execute", "shape"
+        const char *category = nullptr;
+        std::string name;
+        /// full name of the object, may be empty
+        std::string object;
+        /// start time in seconds since the profiler was started
+        double start = 0.0;
+        /// wall time in seconds
+        double duration = 0.0;
+        /// CPU time of the thread in seconds
+        double cpuTime = 0.0;
+        /// sequence number of the thread
+        int thread = 0;
+        /// nesting depth of the scope in its thread
+        int depth = 0;
+        /// whether an enclosing scope has the same category and object
+        bool recursive = false;
+    };
+
+    /// Time spent on an object
+    struct ObjectStats {
+        std::string object;
+        /// number of recomputes
+        int count = 0;
+        /// wall time in seconds of the recomputes
+        double wallTime = 0.0;
+        /// CPU time in seconds of the recomputes
+        double cpuTime = 0.0;
+        /// wall time in seconds of all scopes of each category
+        std::map<std::string, double> categoryTime;
+    };
+
+    /// Start recording, discarding any previous events
+    static void start();
+    /// Stop recording and return the recorded events in the order they finished
+    static std::vector<Event> stop();
+    /// Check whether the profiler is recording
+    static bool isActive() {
+        return _active.load(std::memory_order_relaxed);
+    }
+
+    /// Summarize the events per object, sorted by descending recompute time
+    static std::vector<ObjectStats> summarize(const std::vector<Event> &events);
+    /// Write the events in Chrome trace event format
+    static void writeChromeTrace(std::ostream &out, const std::vector<Event> &events);
+
+    /// Records a scope while the profiler is active
+    class AppExport Scope
+    {
+    public:
+        Scope(const char *category, const char *name, const DocumentObject *obj = nullptr) {
+            if (isActive())
+                begin(category, name, obj);
+        }
+        ~Scope() {
+            if (active)
+                end();
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        void begin(const char *category, const char *name, const DocumentObject *obj);
+        void end();
+
+    private:
+        Event event;
+        long generation = 0;
+        bool active = false;
+    };
+
+private:
+    static std::atomic<bool> _active;
+};
+
+} // namespace App
+
+#endif // APP_RECOMPUTEPROFILER_H
@@ -26,7 +26,11 @@
 #ifndef _PreComp_
 #endif
 
+#include <algorithm>
+#include <climits>
 #include <deque>
+#include <mutex>
+#include <shared_mutex>
 #include <boost/io/ios_state.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -87,16 +91,52 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    bool Concurrent = false;
+    mutable std::shared_mutex Mutex;
 };
 
+namespace {
+
+/// Shared lock of the hash map that is only acquired in concurrent mode
+class ReadLock
+{
+public:
+    explicit ReadLock(const StringHasher::HashMap &map)
+        :lock(map.Mutex, std::defer_lock)
+    {
+        if (map.Concurrent)
+            lock.lock();
+    }
+private:
+    std::shared_lock<std::shared_mutex> lock;
+};
+
+/// Exclusive lock of the hash map that is only acquired in concurrent mode
+class WriteLock
+{
+public:
+    explicit WriteLock(const StringHasher::HashMap &map)
+        :lock(map.Mutex, std::defer_lock)
+    {
+        if (map.Concurrent)
+            lock.lock();
+    }
+private:
+    std::unique_lock<std::shared_mutex> lock;
+};
+
+} // anonymous namespace
+
 ///////////////////////////////////////////////////////////
 
 TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 
 StringID::~StringID()
 {
-    if (_hasher)
+    if (_hasher) {
+        WriteLock lock(*_hasher->_hashes);
         _hasher->_hashes->right.erase(_id);
+    }
 }
 
 PyObject *StringID::getPyObject() {
@@ -178,11 +218,20 @@ void StringHasher::setSaveAll(bool enable) {
     compact();
 }
 
+void StringHasher::setConcurrent(bool enable) {
+    _hashes->Concurrent = enable;
+}
+
+bool StringHasher::isConcurrent() const {
+    return _hashes->Concurrent;
+}
+
 void StringHasher::compact()
 {
     if (_hashes->SaveAll)
         return;
 
+    WriteLock lock(*_hashes);
     std::deque<StringIDRef> pendings;
     for (auto & v : _hashes->right) {
         if (!v.second->isPersistent() && v.second->getRefCount() == 1)
@@ -208,6 +257,7 @@ StringHasher::StorageSizes StringHasher::getStorageSize() const
 {
     StorageSizes sizes;
     std::unordered_set<const char *> dataset;
+    ReadLock lock(*_hashes);
     for (const auto & v : _hashes->right) {
         const StringID &sid = *v.second;
         size_t size = sid._data.size() + sid._postfix.size();
@@ -264,17 +314,20 @@ StringIDRef StringHasher::getID(const QByteArray &data, bool binary, bool hashab
     } else
         d._data = data;
 
-    auto it = _hashes->left.find(&d);
-    if(it!=_hashes->left.end())
-        return StringIDRef(it->first);
+    {
+        ReadLock lock(*_hashes);
+        auto it = _hashes->left.find(&d);
+        if(it!=_hashes->left.end())
+            return StringIDRef(it->first);
+    }
 
     if(!hashed && !nocopy) {
         // if not hashed, make a deep copy of the data
         d._data = QByteArray(data.constData(), data.size());
     }
 
-    StringIDRef sid(new StringID(lastID()+1,d._data,binary,hashed));
-    return StringIDRef(insert(sid));
+    StringIDRef sid(new StringID(0,d._data,binary,hashed));
+    return StringIDRef(insertNew(sid));
 }
 
 StringIDRef StringHasher::getID(const Data::MappedName &name, 
@@ -294,12 +347,15 @@ StringIDRef StringHasher::getID(const Data::MappedName &name,
     else
         d._data = name.dataBytes();
 
-    auto it = _hashes->left.find(&d);
-    if(it!=_hashes->left.end()) {
-        auto res = StringIDRef(it->first);
-        if (indexed)
-            res._index = indexed.getIndex();
-        return res;
+    {
+        ReadLock lock(*_hashes);
+        auto it = _hashes->left.find(&d);
+        if(it!=_hashes->left.end()) {
+            auto res = StringIDRef(it->first);
+            if (indexed)
+                res._index = indexed.getIndex();
+            return res;
+        }
     }
 
     if (!indexed && name.isRaw())
@@ -316,7 +372,7 @@ StringIDRef StringHasher::getID(const Data::MappedName &name,
     if (indexed)
         indexRef = getID(d._data, false, false);
 
-    StringIDRef sid(new StringID(lastID()+1,d._data,false,false));
+    StringIDRef sid(new StringID(0,d._data,false,false));
     StringID & id = *sid._sid;
     if (d._postfix.size()) {
         id._flags.set(StringID::Postfixed);
@@ -379,12 +435,13 @@ StringIDRef StringHasher::getID(const Data::MappedName &name,
         }
     }
 
-    return StringIDRef(insert(sid), indexed.getIndex());
+    return StringIDRef(insertNew(sid), indexed.getIndex());
 }
 
 StringIDRef StringHasher::getID(long id, int index) const {
     if(id<=0)
         return StringIDRef();
+    ReadLock lock(*_hashes);
     auto it = _hashes->right.find(id);
     if(it == _hashes->right.end())
         return StringIDRef();
@@ -406,6 +463,7 @@ const std::string &StringHasher::getPersistenceFileName() const {
 void StringHasher::Save(Base::Writer &writer) const {
 
     size_t count;
+    ReadLock lock(*_hashes);
     if (_hashes->SaveAll)
         count = _hashes->size();
     else {
@@ -444,6 +502,7 @@ void StringHasher::Save(Base::Writer &writer) const {
 void StringHasher::SaveDocFile (Base::Writer &writer) const {
     std::size_t count = _hashes->SaveAll?this->size():this->count();
     writer.Stream() << count << '\n';
+    ReadLock lock(*_hashes);
     saveStream(writer.Stream());
 }
 
@@ -654,6 +713,18 @@ void StringHasher::restoreStreamNew(std::istream &s, std::size_t count) {
     }
 }
 
+StringID * StringHasher::insertNew(const StringIDRef & sid)
+{
+    WriteLock lock(*_hashes);
+    // Another thread may have added the same string since the lookup
+    auto it = _hashes->left.find(sid._sid);
+    if (it != _hashes->left.end())
+        return it->first;
+    // IDs are assigned in insertion order, which is also the saving order
+    sid._sid->_id = lastID()+1;
+    return insert(sid);
+}
+
 StringID * StringHasher::insert(const StringIDRef & sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
@@ -687,6 +758,7 @@ void StringHasher::restoreStream(std::istream &s, std::size_t count) {
 }
 
 void StringHasher::clear() {
+    WriteLock lock(*_hashes);
     for (auto & v : _hashes->right) {
         v.second->_hasher = nullptr;
         v.second->unref();
@@ -695,11 +767,13 @@ void StringHasher::clear() {
 }
 
 size_t StringHasher::size() const {
+    ReadLock lock(*_hashes);
     return _hashes->size();
 }
 
 size_t StringHasher::count() const {
     size_t count = 0;
+    ReadLock lock(*_hashes);
     for(auto &v : _hashes->right) 
         if(v.second->getRefCount()>1)
             ++count;
@@ -752,7 +826,22 @@ void StringHasher::Restore(Base::XMLReader &reader) {
 }
 
 unsigned int StringHasher::getMemSize (void) const {
-    return (_hashes->SaveAll?size():count()) * 10;
+    // Rough estimation of the nodes of both map indices, and of the shared
+    // header allocated by QByteArray, including allocation overhead
+    const std::size_t nodeSize = 6*sizeof(void*) + 32;
+    const std::size_t headerSize = 3*sizeof(void*);
+    std::size_t size = sizeof(HashMap);
+    ReadLock lock(*_hashes);
+    for (auto &v : _hashes->right) {
+        const StringID *sid = v.second;
+        size += sizeof(StringID) + nodeSize
+            + sid->relatedIDs().size() * sizeof(StringIDRef);
+        if (auto len = sid->data().size())
+            size += len + headerSize;
+        if (auto len = sid->postfix().size())
+            size += len + headerSize;
+    }
+    return static_cast<unsigned int>(std::min<std::size_t>(size, UINT_MAX));
 }
 
 PyObject *StringHasher::getPyObject() {
@@ -761,6 +850,7 @@ PyObject *StringHasher::getPyObject() {
 
 std::map<long,StringIDRef> StringHasher::getIDMap() const {
     std::map<long,StringIDRef> ret;
+    ReadLock lock(*_hashes);
     for(auto &v : _hashes->right)
         ret.emplace_hint(ret.end(), v.first, StringIDRef(v.second));
     return ret;
@@ -768,6 +858,7 @@ std::map<long,StringIDRef> StringHasher::getIDMap() const {
 
 void StringHasher::clearMarks() const
 {
+    ReadLock lock(*_hashes);
     for (auto & v : _hashes->right)
         v.second->_flags.reset(StringID::Marked);
 }
@@ -481,6 +481,18 @@ public:
     void setThreshold(int threshold);
     int getThreshold() const;
 
+    /** Enable concurrent access
+     *
+     * In concurrent mode, getID() and the other accessors can be called from
+     * multiple threads. Lookups of existing strings run in parallel, while
+     * insertions are serialized so that the IDs are assigned in insertion
+     * order. Saving and restoring must not run concurrently with anything
+     * else, and the mode shall only be changed when no other thread is using
+     * the hasher.
+     */
+    void setConcurrent(bool enable);
+    bool isConcurrent() const;
+
     void clearMarks() const;
 
     void compact();
@@ -490,6 +502,7 @@ public:
 
 protected:
     StringID * insert(const StringIDRef & sid);
+    StringID * insertNew(const StringIDRef & sid);
     long lastID() const;
     void saveStream(std::ostream &s) const;
     void restoreStream(std::istream &s, std::size_t count);
@@ -136,6 +136,14 @@ void StringHasherPy::setThreshold(Py::Int value) {
     getStringHasherPtr()->setThreshold(value);
 }
 
+Py::Boolean StringHasherPy::getConcurrent(void) const {
+    return Py::Boolean(getStringHasherPtr()->isConcurrent());
+}
+
+void StringHasherPy::setConcurrent(Py::Boolean value) {
+    getStringHasherPtr()->setConcurrent(value);
+}
+
 Py::Dict StringHasherPy::getTable() const {
     Py::Dict dict;
     for(auto &v : getStringHasherPtr()->getIDMap())
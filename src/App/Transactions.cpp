@@ -115,7 +115,42 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize () const
 {
-    return 0;
+    std::unordered_set<const void*> counted;
+    return static_cast<unsigned int>(getMemSize(counted));
+}
+
+std::size_t Transaction::getMemSize(std::unordered_set<const void*> &counted) const
+{
+    std::size_t size = sizeof(*this) + Name.size();
+    for (auto &v : _Objects) {
+        size += v.second->getMemSize(counted);
+        // A removed object is owned by the transaction, see ~Transaction()
+        if (v.second->status == TransactionObject::New
+                && v.first && !v.first->isAttachedToDocument()
+                && counted.insert(v.first).second)
+            size += v.first->getMemSize();
+    }
+    return size;
+}
+
+std::size_t Transaction::getCommittedMemSize() const
+{
+    if (!_CommittedMemSize) {
+        std::unordered_set<const void*> counted;
+        std::vector<Property*> props;
+        for (auto &v : _Objects) {
+            if (!v.first || !v.first->isAttachedToDocument())
+                continue;
+            props.clear();
+            v.first->getPropertyList(props);
+            for (auto prop : props) {
+                if (auto shared = prop->getSharedData())
+                    counted.insert(shared);
+            }
+        }
+        _CommittedMemSize = getMemSize(counted);
+    }
+    return _CommittedMemSize;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -590,7 +625,25 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize () const
 {
-    return 0;
+    std::unordered_set<const void*> counted;
+    return static_cast<unsigned int>(getMemSize(counted));
+}
+
+std::size_t TransactionObject::getMemSize(std::unordered_set<const void*> &counted) const
+{
+    std::size_t size = sizeof(*this) + _NameInDocument.size();
+    for (auto &v : _PropChangeMap) {
+        size += sizeof(v) + v.second.name.size();
+        auto prop = v.second.property;
+        if (!prop)
+            continue;
+        // Copy-on-write properties share their payload with the live
+        // property or with other undo copies. Only count it once.
+        const void *shared = prop->getSharedData();
+        if (!shared || counted.insert(shared).second)
+            size += prop->getMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -26,6 +26,7 @@
 #define APP_TRANSACTION_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include <Base/Factory.h>
 #include <Base/Persistence.h>
 #include <App/PropertyContainer.h>
@@ -66,6 +67,20 @@ public:
     std::string Name;
 
     unsigned int getMemSize () const override;
+    /** Return the memory used by this transaction
+     *
+     * @param counted: shared property data (see Property::getSharedData())
+     *                 already accounted for. Shared data of the properties
+     *                 in this transaction is added to it, so that the same
+     *                 payload is counted only once across multiple calls.
+     */
+    std::size_t getMemSize(std::unordered_set<const void*> &counted) const;
+    /** Return the memory used by this committed transaction
+     *
+     * The size is measured on the first call only, not counting the payloads
+     * shared with the objects changed by this transaction.
+     */
+    std::size_t getCommittedMemSize() const;
     void Save (Base::Writer &writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader &reader) override;
@@ -94,6 +109,7 @@ public:
 
 private:
     int transID;
+    mutable std::size_t _CommittedMemSize = 0;
     using Info = std::pair<const TransactionalObject*, TransactionObject*>;
     bmi::multi_index_container<
         Info,
@@ -126,6 +142,8 @@ public:
     void addOrRemoveProperty(const Property* pcProp, bool add);
 
     unsigned int getMemSize () const override;
+    /// Return the memory used by this object entry, see Transaction::getMemSize()
+    std::size_t getMemSize(std::unordered_set<const void*> &counted) const;
     void Save (Base::Writer &writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader &reader) override;
@@ -24,6 +24,8 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <functional>
+
 #include "BaseClass.h"
 
 namespace Base
@@ -142,6 +144,26 @@ public:
      */
     virtual void RestoreDocFile(Reader &/*reader*/);
 
+    /** Check if the file requested in Restore() can be decoded in a worker thread
+     * @sa RestoreDocFileInThread()
+     */
+    virtual bool canRestoreDocFileInThread() const {return false;}
+
+    /** This method is used to decode a file in a worker thread
+     *
+     * @param reader: the reader of an in memory copy of the file
+     *
+     * @return Return a function that is called in the main thread after all
+     * files are read, to apply the decoded content to this object.
+     *
+     * The method is only called if canRestoreDocFileInThread() returns true
+     * and the reader is set up for parallel restore (see
+     * XMLReader::setRestoreThreadCount()). The implementation must not
+     * modify this or any other object, which shall be done by the returned
+     * function instead.
+     */
+    virtual std::function<void()> RestoreDocFileInThread(Reader &/*reader*/) {return {};}
+
     /// Called by reader to set restoring error
     virtual void SetRestoreError(const char *) {}
 
@@ -27,10 +27,16 @@
 # include <xercesc/sax2/XMLReaderFactory.hpp>
 #endif
 
+#include <cstring>
+#include <deque>
 #include <locale>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include <boost/ref.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 
 #include "Reader.h"
 #include "Base64.h"
@@ -63,6 +69,39 @@ static std::string _ReaderContext;
 
 #define FC_READER_THROW(_msg) _FC_READER_THROW(Base::XMLParseException, _msg)
 
+namespace {
+
+// Append the UTF-8 form of a UTF-16 string without any temporary allocation
+void appendUTF8(std::string &out, const XMLCh *str, const XMLCh *end)
+{
+    for (; str != end && *str; ++str) {
+        char32_t c = *str;
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+            continue;
+        }
+        if (c >= 0xD800 && c < 0xDC00 && str+1 != end && str[1] >= 0xDC00 && str[1] < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (str[1] - 0xDC00);
+            ++str;
+        }
+        if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+        }
+        else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        }
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+}
+
+} // anonymous namespace
+
 ReaderContext::ReaderContext(const char *name)
 {
     init(name);
@@ -172,7 +211,17 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
-    return static_cast<unsigned int>(AttrMap.size());
+    return static_cast<unsigned int>(AttrOffsets.size());
+}
+
+const char *Base::XMLReader::findAttribute(const char *AttrName) const
+{
+    const char *buffer = AttrBuffer.c_str();
+    for (auto &offsets : AttrOffsets) {
+        if (strcmp(buffer + offsets.first, AttrName) == 0)
+            return buffer + offsets.second;
+    }
+    return nullptr;
 }
 
 long Base::XMLReader::getAttributeAsInteger(const char* AttrName, const char *def) const
@@ -192,10 +241,10 @@ double Base::XMLReader::getAttributeAsFloat  (const char* AttrName, const char *
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName, const char *def) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const char *value = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
+    if (value) {
+        return value;
     }
     else if(def) 
         return def;
@@ -206,7 +255,7 @@ const char*  Base::XMLReader::getAttribute (const char* AttrName, const char *de
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 void Base::XMLReader::read()
@@ -261,7 +310,7 @@ void Base::XMLReader::readElement(const char* ElementName, int *guard)
 {
     endCharStream();
 
-    AttrMap.clear();
+    clearAttributes();
 
     int currentLevel = Level;
     std::string currentName = LocalName;
@@ -274,7 +323,7 @@ void Base::XMLReader::readElement(const char* ElementName, int *guard)
                 // Missing element. Consider this as non-fatal
                 FC_ERR("Document XML element '" << (ElementName?ElementName:"") << "' not found\n"
                         << "In context: " << _ReaderContext);
-                AttrMap.clear();
+                clearAttributes();
             }
             break;
         }
@@ -447,13 +496,51 @@ const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object
     FileEntry temp;
     temp.FileName = Name;
     temp.Object = Object;
+    temp.Owner = FileOwner;
 
     FileList.push_back(temp);
     FileNames.push_back( temp.FileName );
+    FileObjects.emplace(temp.FileName, Object);
 
     return Name;
 }
 
+Base::Persistence *Base::XMLReader::setFileOwner(Base::Persistence *owner)
+{
+    if(_reader->getParent())
+        return _reader->getParent()->setFileOwner(owner);
+
+    auto previous = FileOwner;
+    FileOwner = owner;
+    return previous;
+}
+
+void Base::XMLReader::addSharedFile(const std::string &name)
+{
+    if(_reader->getParent())
+        _reader->getParent()->addSharedFile(name);
+    else
+        SharedFiles.insert(name);
+}
+
+bool Base::XMLReader::isSharedFile(const std::string &name) const
+{
+    if(_reader->getParent())
+        return _reader->getParent()->isSharedFile(name);
+    return SharedFiles.count(name) != 0;
+}
+
+Base::Persistence *Base::XMLReader::getFileObject(const std::string &name) const
+{
+    if(_reader->getParent())
+        return _reader->getParent()->getFileObject(name);
+
+    auto it = FileObjects.find(name);
+    if (it == FileObjects.end())
+        return nullptr;
+    return it->second;
+}
+
 const std::vector<std::string>& Base::XMLReader::getFilenames() const
 {
     if(_reader->getParent())
@@ -519,12 +606,19 @@ void Base::XMLReader::endDocument()
 void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* const localname, const XMLCh* const /*qname*/, const XERCES_CPP_NAMESPACE_QUALIFIER Attributes& attrs)
 {
     Level++; // new scope
-    LocalName = StrX(localname).c_str();
+    LocalName.clear();
+    appendUTF8(LocalName, localname, nullptr);
 
     // saving attributes of the current scope, delete all previously stored ones
-    AttrMap.clear();
-    for (unsigned int i = 0; i < attrs.getLength(); i++) {
-        AttrMap[StrX(attrs.getQName(i)).c_str()] = StrXUTF8(attrs.getValue(i)).c_str();
+    clearAttributes();
+    for (XMLSize_t i = 0; i < attrs.getLength(); i++) {
+        std::size_t nameOffset = AttrBuffer.size();
+        appendUTF8(AttrBuffer, attrs.getQName(i), nullptr);
+        AttrBuffer += '\0';
+        std::size_t valueOffset = AttrBuffer.size();
+        appendUTF8(AttrBuffer, attrs.getValue(i), nullptr);
+        AttrBuffer += '\0';
+        AttrOffsets.emplace_back(nameOffset, valueOffset);
     }
 
     ReadType = StartElement;
@@ -533,7 +627,8 @@ void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* cons
 void Base::XMLReader::endElement  (const XMLCh* const /*uri*/, const XMLCh *const localname, const XMLCh *const /*qname*/)
 {
     Level--; // end of scope
-    LocalName = StrX(localname).c_str();
+    LocalName.clear();
+    appendUTF8(LocalName, localname, nullptr);
 
     if (ReadType == StartElement)
         ReadType = StartEndElement;
@@ -556,13 +651,12 @@ void Base::XMLReader::endCDATA ()
 
 void Base::XMLReader::characters(const   XMLCh* const chars, const XMLSize_t length)
 {
-    (void)length;
     ReadType = Chars;
 
     // We only capture characters when some one wants it
     if(CharacterOffset>=0) {
         Characters.erase(Characters.begin(), Characters.begin()+CharacterOffset);
-        Characters += StrXUTF8(chars).c_str();
+        appendUTF8(Characters, chars, chars + length);
         CharacterOffset = 0;
     }
 }
@@ -696,6 +790,41 @@ Base::ZipReader::ZipReader(zipios::ZipInputStream &str, const std::string &name,
 {
 }
 
+namespace {
+
+// Decodes an in memory copy of a file in a worker thread
+class RestoreDocFileJob : public QRunnable
+{
+public:
+    RestoreDocFileJob(const XMLReader::FileEntry &entry, std::string &&data, XMLReader *parent)
+        : entry(entry), data(std::move(data)), parent(parent)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        try {
+            bio::stream<bio::array_source> stream(data.data(), data.size());
+            Base::Reader reader(stream, entry.FileName, parent);
+            apply = entry.Object->RestoreDocFileInThread(reader);
+        } catch (std::exception &e) {
+            message = e.what();
+        } catch (...) {
+            message = "Unknown exception";
+        }
+        std::string().swap(data);
+    }
+
+    XMLReader::FileEntry entry;
+    std::string data;
+    XMLReader *parent;
+    std::function<void()> apply;
+    std::string message;
+};
+
+} // anonymous namespace
+
 void Base::ZipReader::readFiles(XMLReader &xmlReader)
 {
     // It's possible that not all objects inside the document could be created, e.g. if a module
@@ -718,6 +847,17 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
     const auto &FileList = xmlReader.getFileList();
     std::size_t it = 0;
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
+
+    std::deque<std::unique_ptr<RestoreDocFileJob>> jobs;
+    // Declared after 'jobs' so that it is destroyed first, which waits for
+    // any running job in case of exception.
+    std::unique_ptr<QThreadPool> pool;
+    if (xmlReader.getRestoreThreadCount()) {
+        pool.reset(new QThreadPool);
+        if (xmlReader.getRestoreThreadCount() > 0)
+            pool->setMaxThreadCount(xmlReader.getRestoreThreadCount());
+    }
+
     while (entry->isValid() && it < FileList.size()) {
         auto jt = it;
         // Check if the current entry is registered, otherwise check the next registered files as soon as
@@ -728,8 +868,14 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
         // no file name for the current entry in the zip was registered.
         if (jt < FileList.size()) {
             try {
-                Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
-                FileList[jt].Object->RestoreDocFile(zipreader);
+                if (pool && FileList[jt].Object->canRestoreDocFileInThread()) {
+                    std::string data(std::istreambuf_iterator<char>(_stream), {});
+                    jobs.emplace_back(new RestoreDocFileJob(FileList[jt], std::move(data), &xmlReader));
+                    pool->start(jobs.back().get());
+                } else {
+                    Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
+                    FileList[jt].Object->RestoreDocFile(zipreader);
+                }
             } catch(Base::AbortException &e) {
                 e.ReportException();
                 FC_ERR("User abort when reading embedded file: " << FileList[jt].FileName);
@@ -760,6 +906,26 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
             break;
         }
     }
+
+    if (!pool)
+        return;
+
+    pool->waitForDone();
+    for (auto &job : jobs) {
+        if (!job->message.empty()) {
+            FC_ERR("Reading failed from embedded file: " << job->entry.FileName << ", " << job->message);
+            continue;
+        }
+        try {
+            if (job->apply)
+                job->apply();
+        } catch(Base::Exception &e) {
+            e.ReportException();
+            FC_ERR("Reading failed from embedded file: " << job->entry.FileName);
+        } catch(...) {
+            FC_ERR("Reading failed from embedded file: " << job->entry.FileName);
+        }
+    }
 }
 
 
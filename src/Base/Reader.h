@@ -28,6 +28,9 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/Attributes.hpp>
@@ -243,12 +246,35 @@ public:
     struct FileEntry {
         std::string FileName;
         Base::Persistence *Object;
+        /// The object being restored at the time the file is added, e.g. a property
+        Base::Persistence *Owner;
     };
     const std::vector<FileEntry> &getFileList() const;
+    /** Set the owner of the files added afterwards
+     * @return Returns the previous owner
+     */
+    Base::Persistence *setFileOwner(Base::Persistence *owner);
+    /// Mark the file content as referred by or referring to other file
+    void addSharedFile(const std::string &name);
+    /// Check if the file content is referred by or refers to other file
+    bool isSharedFile(const std::string &name) const;
 
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
     bool isRegistered(Base::Persistence *Object) const;
+    /// get the object that requested to read the given file
+    Base::Persistence *getFileObject(const std::string &name) const;
+    /** Set the number of threads used to decode the requested files
+     *
+     * @param count: zero to read the files sequentially, negative to use
+     * the ideal thread count of the machine.
+     *
+     * Only files of objects supporting Persistence::RestoreDocFileInThread()
+     * are decoded in parallel. The other files are read in the calling thread
+     * in their original order.
+     */
+    void setRestoreThreadCount(int count) {RestoreThreadCount = count;}
+    int getRestoreThreadCount() const {return RestoreThreadCount;}
     virtual void addName(const char*, const char*);
     virtual const char* getName(const char*) const;
     virtual bool doNameMapping() const;
@@ -321,8 +347,22 @@ protected:
     std::string Characters;
     std::streamsize CharacterOffset;
 
-    std::map<std::string,std::string> AttrMap;
-    using AttrMapType = std::map<std::string,std::string>;
+    /** Attributes of the current element
+     *
+     * Stored as consecutive null terminated names and values in a single
+     * buffer, which keeps its capacity among elements to avoid allocation.
+     * Elements usually have only a few attributes, so that a linear search
+     * is faster than any map.
+     */
+    std::string AttrBuffer;
+    /// offsets of the name and value of each attribute in AttrBuffer
+    std::vector<std::pair<std::size_t, std::size_t> > AttrOffsets;
+
+    void clearAttributes() {
+        AttrBuffer.clear();
+        AttrOffsets.clear();
+    }
+    const char *findAttribute(const char *AttrName) const;
 
     enum {
         None = 0,
@@ -345,9 +385,14 @@ protected:
 
     std::vector<FileEntry> FileList;
     std::vector<std::string> FileNames;
+    std::unordered_map<std::string, Base::Persistence*> FileObjects;
+    std::unordered_set<std::string> SharedFiles;
+    Base::Persistence *FileOwner = nullptr;
 
     std::vector<int*> Guards;
 
+    int RestoreThreadCount = 0;
+
     std::bitset<32> StatusBits;
 
     std::unique_ptr<std::istream> CharStream;
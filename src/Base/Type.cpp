@@ -23,7 +23,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <atomic>
 # include <cassert>
+# include <mutex>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -49,12 +51,21 @@ struct Base::TypeData
   Type parent;
   Type type;
   Type::instantiationMethod instMethod;
+  /// pre-order number of the type in the type tree
+  unsigned int first = 0;
+  /// highest pre-order number of the types derived from this one
+  unsigned int last = 0;
 };
 
 map<string,unsigned int> Type::typemap;
 vector<TypeData*>        Type::typedata;
 set<string>              Type::loadModuleSet;
 
+// The type intervals are renumbered on first use after new types have been
+// registered, i.e. once after each module is loaded.
+static std::atomic<bool> _TypeIntervalsValid(false);
+static std::mutex _TypeIntervalsMutex;
+
 //**************************************************************************
 // Construction/Destruction
 
@@ -148,6 +159,8 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   // add to dictionary for fast lookup
   Type::typemap[name] = newType.getKey();
 
+  _TypeIntervalsValid.store(false, std::memory_order_release);
+
   return newType;
 }
 
@@ -170,6 +183,7 @@ void Type::destruct()
   typedata.clear();
   typemap.clear();
   loadModuleSet.clear();
+  _TypeIntervalsValid = false;
 }
 
 Type Type::fromName(const char *name)
@@ -201,17 +215,62 @@ const Type Type::getParent() const
   return typedata[index]->parent;
 }
 
+void Type::updateIntervals()
+{
+  std::lock_guard<std::mutex> lock(_TypeIntervalsMutex);
+  if (_TypeIntervalsValid.load(std::memory_order_acquire))
+    return;
+
+  // Number the type tree in pre-order, so that the types derived from a
+  // given type occupy the range [first, last] of that type. Since a parent
+  // is always registered before its children, the children lists come out
+  // sorted by registration order.
+  std::vector<std::vector<unsigned int>> children(typedata.size());
+  std::vector<unsigned int> roots;
+  for (unsigned int i = 1; i < typedata.size(); ++i) {
+    unsigned int parent = typedata[i]->parent.getKey();
+    if (parent && parent < i)
+      children[parent].push_back(i);
+    else
+      roots.push_back(i);
+  }
+
+  unsigned int counter = 0;
+  typedata[0]->first = typedata[0]->last = counter++;
+
+  std::vector<std::pair<unsigned int, std::size_t>> stack;
+  for (unsigned int root : roots) {
+    typedata[root]->first = counter++;
+    stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto &childList = children[top.first];
+      if (top.second < childList.size()) {
+        unsigned int child = childList[top.second++];
+        typedata[child]->first = counter++;
+        stack.emplace_back(child, 0);
+      }
+      else {
+        typedata[top.first]->last = counter - 1;
+        stack.pop_back();
+      }
+    }
+  }
+
+  _TypeIntervalsValid.store(true, std::memory_order_release);
+}
+
 bool Type::isDerivedFrom(const Type type) const
 {
+  if (type.index == 0 || this->index == 0)
+    return this->index == type.index;
 
-  Type temp(*this);
-  do {
-    if (temp == type)
-      return true;
-    temp = temp.getParent();
-  } while (temp != badType());
+  if (!_TypeIntervalsValid.load(std::memory_order_acquire))
+    updateIntervals();
 
-  return false;
+  const TypeData *self = typedata[this->index];
+  const TypeData *base = typedata[type.index];
+  return self->first >= base->first && self->first <= base->last;
 }
 
 int Type::getAllDerivedFrom(const Type type, std::vector<Type> & List)
@@ -129,6 +129,8 @@ protected:
 
 
 private:
+  /// Renumber the derivation intervals used by isDerivedFrom()
+  static void updateIntervals();
 
 
   unsigned int index;
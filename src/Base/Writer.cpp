@@ -23,8 +23,14 @@
 
 #include "PreCompiled.h"
 
+#include <chrono>
+#include <deque>
+#include <future>
 #include <limits>
 #include <locale>
+#include <QRunnable>
+#include <QThreadPool>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
@@ -257,9 +263,17 @@ const std::string &Writer::addFile(const char* Name,const Base::Persistence *Obj
     FileNames.push_back(entry.FileName);
 
     entry.Object = Object;
+    entry.Owner = FileOwner;
     return entry.FileName;
 }
 
+const Base::Persistence *Writer::setFileOwner(const Base::Persistence *owner)
+{
+    auto previous = FileOwner;
+    FileOwner = owner;
+    return previous;
+}
+
 std::string Writer::getUniqueFileName(const char *Name)
 {
     std::vector<std::string> names;
@@ -285,6 +299,21 @@ const std::vector<std::string>& Writer::getFilenames() const
     return FileNames;
 }
 
+std::string Writer::registerFileContent(const std::string &key)
+{
+    auto res = FileContents.emplace(key, ObjectName);
+    if (res.second)
+        return std::string();
+    SharedFiles.insert(ObjectName);
+    SharedFiles.insert(res.first->second);
+    return res.first->second;
+}
+
+bool Writer::isSharedFile(const std::string &name) const
+{
+    return SharedFiles.count(name) != 0;
+}
+
 void Writer::incInd()
 {
     int pos = sizeof(indBuf)-1;
@@ -344,18 +373,267 @@ void ZipWriter::putNextEntry(const char *file, const char *obj) {
     ZipStream.putNextEntry(file);
 }
 
+bool ZipWriter::setPreviousArchive(const std::string &path)
+{
+    PreviousArchive.reset();
+    PreviousStream.reset();
+    ReusedFiles.clear();
+    try {
+        std::unique_ptr<zipios::ZipFile> archive(new zipios::ZipFile(path));
+        std::unique_ptr<std::istream> stream(
+                new Base::ifstream(FileInfo(path), std::ios::in | std::ios::binary));
+        if (!archive->isValid() || !*stream)
+            return false;
+        PreviousArchive = std::move(archive);
+        PreviousStream = std::move(stream);
+        return true;
+    }
+    catch (const std::exception &) {
+        return false;
+    }
+}
+
+void ZipWriter::reuseFile(const std::string &name, const std::string &previous)
+{
+    if (PreviousArchive)
+        ReusedFiles[name] = previous;
+}
+
+bool ZipWriter::readPreviousFile(const std::string &name, std::string &data,
+                                 uint32 &size, uint32 &crc)
+{
+    auto it = ReusedFiles.find(name);
+    if (it == ReusedFiles.end() || !PreviousArchive)
+        return false;
+
+    try {
+        ConstEntryPointer entry = PreviousArchive->getEntry(it->second);
+        auto cdirEntry = dynamic_cast<const ZipCDirEntry*>(entry.get());
+        if (!cdirEntry || !cdirEntry->isValid() || cdirEntry->getMethod() != DEFLATED)
+            return false;
+
+        // Skip the local header, whose name and extra field may differ in
+        // size from the ones in the central directory.
+        auto &in = *PreviousStream;
+        in.clear();
+        in.seekg(cdirEntry->getLocalHeaderOffset());
+        unsigned char header[30];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))
+                || header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4)
+            return false;
+        int nameLength = header[26] | (header[27] << 8);
+        int extraLength = header[28] | (header[29] << 8);
+        in.seekg(nameLength + extraLength, std::ios::cur);
+
+        data.resize(cdirEntry->getCompressedSize());
+        if (!in.read(&data[0], data.size()))
+            return false;
+        size = cdirEntry->getSize();
+        crc = cdirEntry->getCrc();
+        ++ReusedFileCount;
+        return true;
+    }
+    catch (const std::exception &) {
+        return false;
+    }
+}
+
+namespace {
+
+// Deflates a serialized doc file into a raw deflate stream (i.e. without
+// zlib header) as expected by zip entries using the DEFLATED method
+class ZipEntryJob : public QRunnable
+{
+public:
+    ZipEntryJob(std::string &&data, int level)
+        : data(std::move(data)), level(level)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        try {
+            deflateData();
+            promise.set_value();
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    std::string data;
+    std::string result;
+    std::size_t size = 0;
+    uLong crc = 0;
+    int level;
+    std::promise<void> promise;
+
+private:
+    void deflateData()
+    {
+        z_stream zs{};
+        if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw Base::RuntimeError("Failed to initialize zip compression");
+
+        const std::size_t chunk = 1 << 20;
+        auto input = reinterpret_cast<const Bytef*>(data.data());
+        std::size_t remain = data.size();
+        int err = Z_OK;
+        size = remain;
+        crc = crc32(0, Z_NULL, 0);
+        result.reserve(remain/2);
+        do {
+            auto count = static_cast<uInt>(std::min(remain, chunk));
+            crc = crc32(crc, input, count);
+            zs.next_in = const_cast<Bytef*>(input);
+            zs.avail_in = count;
+            input += count;
+            remain -= count;
+            int flush = remain ? Z_NO_FLUSH : Z_FINISH;
+            do {
+                std::size_t offset = result.size();
+                result.resize(offset + chunk);
+                zs.next_out = reinterpret_cast<Bytef*>(&result[offset]);
+                zs.avail_out = static_cast<uInt>(chunk);
+                err = deflate(&zs, flush);
+                result.resize(offset + chunk - zs.avail_out);
+            } while (zs.avail_out == 0 && err != Z_STREAM_ERROR);
+        } while (remain && err != Z_STREAM_ERROR);
+        deflateEnd(&zs);
+
+        // release the input as early as possible
+        std::string().swap(data);
+
+        if (err != Z_STREAM_END)
+            throw Base::RuntimeError("Failed to compress zip entry");
+    }
+};
+
+} // anonymous namespace
+
+void ZipWriter::writeFilesParallel()
+{
+    struct PendingEntry {
+        std::string name;
+        std::unique_ptr<ZipEntryJob> job;
+        std::future<void> future;
+    };
+    std::deque<PendingEntry> pending;
+    std::size_t pendingSize = 0;
+
+    // Declared after 'pending' so that it is destroyed first, which waits
+    // for any running job in case of exception.
+    QThreadPool pool;
+    if (ThreadCount > 0)
+        pool.setMaxThreadCount(ThreadCount);
+
+    auto writeEntry = [&]() {
+        auto &entry = pending.front();
+        entry.future.get();
+        auto &job = *entry.job;
+        ZipStream.putRawEntry(ZipCDirEntry(entry.name),
+                              job.result.data(),
+                              static_cast<uint32>(job.result.size()),
+                              static_cast<uint32>(job.size),
+                              static_cast<uint32>(job.crc));
+        pendingSize -= job.size;
+        pending.pop_front();
+    };
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList[index++];
+
+        std::string data;
+        uint32 size, crc;
+        if (readPreviousFile(entry.FileName, data, size, crc)) {
+            // Queue the copied content as an already finished job to keep
+            // the order of entries
+            auto job = std::make_unique<ZipEntryJob>(std::string(), Level);
+            job->result = std::move(data);
+            job->size = size;
+            job->crc = crc;
+            job->promise.set_value();
+            pendingSize += job->size;
+            pending.push_back({entry.FileName, std::move(job), std::future<void>()});
+            pending.back().future = pending.back().job->promise.get_future();
+            continue;
+        }
+
+        Writer::putNextEntry(entry.FileName.c_str());
+        indent = 0;
+        indBuf[0] = 0;
+
+        std::ostringstream buffer;
+        buffer.imbue(ZipStream.getloc());
+        buffer.precision(ZipStream.precision());
+        buffer.flags(ZipStream.flags());
+        EntryStream = &buffer;
+        try {
+            entry.Object->SaveDocFile(*this);
+        }
+        catch (...) {
+            EntryStream = nullptr;
+            throw;
+        }
+        EntryStream = nullptr;
+
+        auto job = std::make_unique<ZipEntryJob>(buffer.str(), Level);
+        buffer.str(std::string());
+        std::size_t size = job->data.size();
+        pendingSize += size;
+        pending.push_back({entry.FileName, std::move(job), std::future<void>()});
+        auto &item = pending.back();
+        item.future = item.job->promise.get_future();
+        // Not worth the overhead of dispatching small files
+        if (size < 64 * 1024)
+            item.job->run();
+        else
+            pool.start(item.job.get());
+
+        // Write out whatever is ready, and block if too much is pending
+        while (!pending.empty()) {
+            if (pendingSize <= MaxPendingSize
+                    && pending.front().future.wait_for(std::chrono::seconds(0))
+                        != std::future_status::ready)
+                break;
+            writeEntry();
+        }
+    }
+
+    while (!pending.empty())
+        writeEntry();
+}
+
 void ZipWriter::writeFiles()
 {
+    if (ThreadCount != 0) {
+        writeFilesParallel();
+        return;
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
+        index++;
+
+        std::string data;
+        uint32 size, crc;
+        if (readPreviousFile(entry.FileName, data, size, crc)) {
+            ZipStream.putRawEntry(ZipCDirEntry(entry.FileName), data.data(),
+                                  static_cast<uint32>(data.size()), size, crc);
+            continue;
+        }
+
         putNextEntry(entry.FileName.c_str());
         indent = 0;
         indBuf[0] = 0;
         entry.Object->SaveDocFile(*this);
-        index++;
     }
 }
 
@@ -25,6 +25,7 @@
 
 
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <sstream>
@@ -102,6 +103,32 @@ public:
     virtual void writeFiles()=0;
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
+
+    struct FileEntry {
+        std::string FileName;
+        const Base::Persistence *Object;
+        /// The object being saved at the time the file is added, e.g. a property
+        const Base::Persistence *Owner;
+    };
+    /// get all registered files
+    const std::vector<FileEntry>& getFileList() const {
+        return FileList;
+    }
+    /** Set the owner of the files added afterwards
+     * @return Returns the previous owner
+     */
+    const Base::Persistence *setFileOwner(const Base::Persistence *owner);
+    /** Register the content of the file currently being written
+     *
+     * @param key: a key uniquely identifying the content, e.g. a hash
+     *
+     * @return Return the name of an earlier file registered with the same
+     * key, or an empty string if there is none. This allows the caller to
+     * write a reference to the earlier file instead of duplicating content.
+     */
+    std::string registerFileContent(const std::string &key);
+    /// Check if the file content is referred by or refers to other file
+    bool isSharedFile(const std::string &name) const;
     /// Set mode
     void setMode(const std::string& mode);
     /// Set modes
@@ -162,13 +189,12 @@ public:
 
 protected:
     std::string getUniqueFileName(const char *Name);
-    struct FileEntry {
-        std::string FileName;
-        const Base::Persistence *Object;
-    };
     std::vector<FileEntry> FileList;
     std::vector<std::string> FileNames;
     std::unordered_set<std::string> FileNameSet;
+    std::unordered_map<std::string, std::string> FileContents;
+    std::unordered_set<std::string> SharedFiles;
+    const Base::Persistence *FileOwner = nullptr;
     std::vector<std::string> Errors;
     std::set<std::string> Modes;
 
@@ -210,14 +236,63 @@ public:
 
     void writeFiles() override;
 
-    std::ostream &Stream() override{return ZipStream;}
+    std::ostream &Stream() override{return EntryStream?*EntryStream:ZipStream;}
 
     void setComment(const char* str){ZipStream.setComment(str);}
-    void setLevel(int level){ZipStream.setLevel( level );}
+    void setLevel(int level){ZipStream.setLevel( level ); Level = level;}
     void putNextEntry(const char *filename, const char *objName=nullptr) override;
 
+    /** Set the number of threads used to compress the doc files
+     *
+     * @param count: zero to write the files sequentially, negative to use
+     * the ideal thread count of the machine.
+     *
+     * When enabled, the files are serialized into memory in the calling
+     * thread, deflated concurrently, and then written into the archive in
+     * the original order. The resulting archive is the same as the one
+     * written sequentially.
+     */
+    void setThreadCount(int count){ThreadCount = count;}
+    /// Limit the size of serialized files waiting to be compressed and written
+    void setMaxPendingSize(std::size_t size){MaxPendingSize = size;}
+
+    /** Set a previously saved archive to copy unchanged files from
+     *
+     * @param path: the path of the archive. It must not be the same file
+     * this writer is writing to.
+     *
+     * @return Return false if the archive cannot be opened.
+     */
+    bool setPreviousArchive(const std::string &path);
+    /// Check if there is a previous archive to copy files from
+    bool hasPreviousArchive() const {return !!PreviousArchive;}
+    /** Copy a file from the previous archive instead of calling SaveDocFile()
+     *
+     * @param name: the file name as returned by addFile()
+     * @param previous: the file name in the previous archive
+     *
+     * The compressed content is copied as it is. If the file cannot be
+     * found in the previous archive, it is saved normally.
+     */
+    void reuseFile(const std::string &name, const std::string &previous);
+    /// Return the number of files copied from the previous archive
+    int getReusedFileCount() const {return ReusedFileCount;}
+
+private:
+    void writeFilesParallel();
+    bool readPreviousFile(const std::string &name, std::string &data,
+                          zipios::uint32 &size, zipios::uint32 &crc);
+
 private:
     zipios::ZipOutputStream ZipStream;
+    std::ostream *EntryStream = nullptr;
+    int Level = 6;
+    int ThreadCount = 0;
+    std::size_t MaxPendingSize = 256 << 20;
+    std::unique_ptr<zipios::ZipFile> PreviousArchive;
+    std::unique_ptr<std::istream> PreviousStream;
+    std::unordered_map<std::string, std::string> ReusedFiles;
+    int ReusedFileCount = 0;
 };
 
 /** The StringWriter class
@@ -324,6 +324,7 @@ struct DocumentP
     Connection connectTransactionRemove;
     Connection connectTouchedObject;
     Connection connectPurgeTouchedObject;
+    Connection connectMemoryReport;
     Connection connectChangePropertyEditor;
     Connection connectStartSave;
     Connection connectChangeDocument;
@@ -431,6 +432,8 @@ Document::Document(App::Document* pcDocument,Application * app)
         (boost::bind(&Gui::Document::slotTouchedObject, this, bp::_1));
     d->connectPurgeTouchedObject = pcDocument->signalPurgeTouchedObject.connect
         (boost::bind(&Gui::Document::slotTouchedObject, this, bp::_1));
+    d->connectMemoryReport = pcDocument->signalMemoryReport.connect
+        (boost::bind(&Gui::Document::slotMemoryReport, this, bp::_1, bp::_2));
 
     d->connectTransactionAppend = pcDocument->signalTransactionAppend.connect
         (boost::bind(&Gui::Document::slotTransactionAppend, this, bp::_1, bp::_2));
@@ -476,6 +479,10 @@ Document::Document(App::Document* pcDocument,Application * app)
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
         d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // set the maximum memory of the undo stack in MB, zero for no limit
+        long undoMemSize = std::max(0L, hGrp->GetInt("MaxUndoMemSize",0));
+        d->_pcDocument->setUndoLimit(
+                static_cast<unsigned int>(std::min(undoMemSize, 4095L)) * 1024u * 1024u);
     }
 
     d->_changeViewTouchDocument = hGrp->GetBool("ChangeViewProviderTouchDocument", true);
@@ -507,6 +514,7 @@ Document::~Document()
     d->connectTransactionRemove.disconnect();
     d->connectTouchedObject.disconnect();
     d->connectPurgeTouchedObject.disconnect();
+    d->connectMemoryReport.disconnect();
     d->connectChangePropertyEditor.disconnect();
     d->connectStartSave.disconnect();
     d->connectChangeDocument.disconnect();
@@ -1287,6 +1295,18 @@ void Document::slotTouchedObject(const App::DocumentObject &Obj)
     }
 }
 
+void Document::slotMemoryReport(const App::Document&, App::Document::MemoryReport &report)
+{
+    std::unordered_set<const SoNode*> counted;
+    for (const auto &v : d->_ViewProviderMap) {
+        const char *name = v.first->getNameInDocument();
+        if (!name)
+            continue;
+        std::size_t size = v.second->getMemSize() + v.second->getNodeMemSize(counted);
+        report.add(name, "ViewProvider", size);
+    }
+}
+
 void Document::addViewProvider(Gui::ViewProviderDocumentObject* vp)
 {
     // Hint: The undo/redo first adds the view provider to the Gui
@@ -96,6 +96,7 @@ protected:
     void slotRecomputed(const App::Document&, const std::vector<App::DocumentObject*> &);
     void slotSkipRecompute(const App::Document &doc, const std::vector<App::DocumentObject*> &objs);
     void slotTouchedObject(const App::DocumentObject &);
+    void slotMemoryReport(const App::Document&, App::Document::MemoryReport &report);
     void slotChangePropertyEditor(const App::Document&, const App::Property &);
     //@}
 
@@ -31,6 +31,21 @@
 # include <Inventor/events/SoKeyboardEvent.h>
 # include <Inventor/events/SoLocation2Event.h>
 # include <Inventor/events/SoMouseButtonEvent.h>
+# include <Inventor/fields/SoMFColor.h>
+# include <Inventor/fields/SoMFEnum.h>
+# include <Inventor/fields/SoMFFloat.h>
+# include <Inventor/fields/SoMFInt32.h>
+# include <Inventor/fields/SoMFMatrix.h>
+# include <Inventor/fields/SoMFNode.h>
+# include <Inventor/fields/SoMFRotation.h>
+# include <Inventor/fields/SoMFShort.h>
+# include <Inventor/fields/SoMFString.h>
+# include <Inventor/fields/SoMFUInt32.h>
+# include <Inventor/fields/SoMFUShort.h>
+# include <Inventor/fields/SoMFVec2f.h>
+# include <Inventor/fields/SoMFVec3f.h>
+# include <Inventor/fields/SoSFNode.h>
+# include <Inventor/lists/SoFieldList.h>
 # include <Inventor/nodes/SoCamera.h>
 # include <Inventor/nodes/SoSeparator.h>
 # include <Inventor/nodes/SoSwitch.h>
@@ -918,6 +933,74 @@ void ViewProvider::updateData(const App::Property* prop)
     callExtension(&ViewProviderExtension::extensionUpdateData,prop);
 }
 
+static std::size_t getMFieldValueSize(const SoMField *field)
+{
+    if (field->isOfType(SoMFVec3f::getClassTypeId()))
+        return sizeof(SbVec3f);
+    if (field->isOfType(SoMFColor::getClassTypeId()))
+        return sizeof(SbColor);
+    if (field->isOfType(SoMFVec2f::getClassTypeId()))
+        return sizeof(SbVec2f);
+    if (field->isOfType(SoMFInt32::getClassTypeId())
+            || field->isOfType(SoMFUInt32::getClassTypeId())
+            || field->isOfType(SoMFFloat::getClassTypeId())
+            || field->isOfType(SoMFEnum::getClassTypeId()))
+        return 4;
+    if (field->isOfType(SoMFShort::getClassTypeId())
+            || field->isOfType(SoMFUShort::getClassTypeId()))
+        return 2;
+    if (field->isOfType(SoMFRotation::getClassTypeId()))
+        return sizeof(SbRotation);
+    if (field->isOfType(SoMFMatrix::getClassTypeId()))
+        return sizeof(SbMatrix);
+    if (field->isOfType(SoMFString::getClassTypeId()))
+        return sizeof(SbString);
+    return sizeof(void*);
+}
+
+static std::size_t getNodeMemSize(const SoNode *node, std::unordered_set<const SoNode*> &counted)
+{
+    if (!node || !counted.insert(node).second)
+        return 0;
+
+    // Rough estimation of the node instance, and of its field values
+    std::size_t size = 64;
+    SoFieldList fields;
+    int count = node->getFields(fields);
+    for (int i = 0; i < count; ++i) {
+        SoField *field = fields[i];
+        size += 2*sizeof(void*);
+        if (field->isOfType(SoSFNode::getClassTypeId())) {
+            size += getNodeMemSize(static_cast<SoSFNode*>(field)->getValue(), counted);
+        }
+        else if (field->isOfType(SoMFNode::getClassTypeId())) {
+            auto nodes = static_cast<SoMFNode*>(field);
+            for (int j = 0; j < nodes->getNum(); ++j)
+                size += sizeof(void*) + getNodeMemSize((*nodes)[j], counted);
+        }
+        else if (field->isOfType(SoMField::getClassTypeId())) {
+            auto mfield = static_cast<SoMField*>(field);
+            size += mfield->getNum() * getMFieldValueSize(mfield);
+        }
+    }
+
+    if (node->isOfType(SoGroup::getClassTypeId())) {
+        auto group = static_cast<const SoGroup*>(node);
+        for (int i = 0; i < group->getNumChildren(); ++i)
+            size += sizeof(void*) + getNodeMemSize(group->getChild(i), counted);
+    }
+    return size;
+}
+
+std::size_t ViewProvider::getNodeMemSize(std::unordered_set<const SoNode*> &counted) const
+{
+    std::size_t size = ::getNodeMemSize(getRoot(), counted);
+    size += ::getNodeMemSize(pcAnnotation, counted);
+    size += ::getNodeMemSize(getFrontRoot(), counted);
+    size += ::getNodeMemSize(getBackRoot(), counted);
+    return size;
+}
+
 SoSeparator* ViewProvider::getBackRoot() const
 {
     SoSeparator *node = 0;
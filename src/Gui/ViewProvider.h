@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <QIcon>
 #include <QPixmap>
@@ -119,6 +120,12 @@ public:
     virtual SoGroup* getChildRoot() const;
     // returns the root node of the Provider (3D)
     virtual SoSeparator* getBackRoot() const;
+    /** Returns the estimated memory in bytes used by the Inventor nodes of the provider
+     *
+     * @param counted: nodes already counted, to count nodes shared between
+     * providers only once
+     */
+    std::size_t getNodeMemSize(std::unordered_set<const SoNode*> &counted) const;
     ///Indicate whether to be added to scene graph or not
     virtual bool canAddToSceneGraph() const {return true;}
 
@@ -81,6 +81,7 @@ Base::BoundBox3d PropertyFemMesh::getBoundingBox() const
 void PropertyFemMesh::setTransform(const Base::Matrix4D &rclTrf)
 {
     _FemMesh->setTransform(rclTrf);
+    setStatus(Saved, false);
 }
 
 Base::Matrix4D PropertyFemMesh::getTransform() const
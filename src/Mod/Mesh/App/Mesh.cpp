@@ -352,7 +352,15 @@ void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet>
 
 unsigned int MeshObject::getMemSize () const
 {
-    return _kernel.GetMemSize();
+    std::size_t size = _kernel.GetMemSize();
+    for (const auto& segment : _segments)
+        size += sizeof(Segment) + segment.getIndices().size() * sizeof(FacetIndex);
+    return static_cast<unsigned int>(size);
+}
+
+void MeshObject::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    sizes["Mesh"] += getMemSize();
 }
 
 void MeshObject::Save (Base::Writer &/*writer*/) const
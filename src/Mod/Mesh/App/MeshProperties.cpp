@@ -608,38 +608,56 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    _meshObject = mesh;
+    resetMeshObject(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
-    *_meshObject = mesh;
+    detachMeshObject(false)->operator = (mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->setKernel(mesh);
+    detachMeshObject(false)->setKernel(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detachMeshObject()->swap(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detachMeshObject()->swap(mesh);
     hasSetValue();
 }
 
+void PropertyMeshKernel::resetMeshObject(MeshObject* mesh)
+{
+    _meshObject = mesh;
+    if (meshPyObject)
+        meshPyObject->setTwinPointer(mesh);
+}
+
+MeshObject* PropertyMeshKernel::detachMeshObject(bool copyData)
+{
+    if (_meshObject->getRefCount() > 1) {
+        if (copyData)
+            resetMeshObject(new MeshObject(*_meshObject));
+        else
+            resetMeshObject(new MeshObject(MeshCore::MeshKernel(), _meshObject->getTransform()));
+    }
+    return static_cast<MeshObject*>(_meshObject);
+}
+
 const MeshObject& PropertyMeshKernel::getValue()const
 {
     return *_meshObject;
@@ -671,7 +689,7 @@ unsigned int PropertyMeshKernel::getMemSize () const
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
-    return static_cast<MeshObject*>(_meshObject);
+    return detachMeshObject();
 }
 
 void PropertyMeshKernel::finishEditing()
@@ -682,14 +700,14 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
-    _meshObject->transformGeometry(rclMat);
+    detachMeshObject()->transformGeometry(rclMat);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    MeshCore::MeshKernel& kernel = detachMeshObject()->getKernel();
     for (std::vector<std::pair<PointIndex, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
     hasSetValue();
@@ -697,7 +715,13 @@ void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex,
 
 void PropertyMeshKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
-    _meshObject->setTransform(rclTrf);
+    // The placement is part of the mesh object, so it cannot be changed
+    // while shared with an undo copy
+    if (_meshObject->getTransform() == rclTrf)
+        return;
+    detachMeshObject()->setTransform(rclTrf);
+    // not signaled, so do not reuse the file of the last save
+    setStatus(Saved, false);
 }
 
 Base::Matrix4D PropertyMeshKernel::getTransform() const
@@ -770,7 +794,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
-        _meshObject->getKernel().Adopt(points, facets);
+        detachMeshObject(false)->getKernel().Adopt(points, facets);
         hasSetValue();
     }
     else {
@@ -787,23 +811,28 @@ void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
-    _meshObject->load(reader);
+    detachMeshObject(false)->load(reader);
     hasSetValue();
 }
 
 App::Property *PropertyMeshKernel::Copy() const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: The copy references the same mesh object, which is copied by
+    // detachMeshObject() on the first modification of either property.
     PropertyMeshKernel *prop = new PropertyMeshKernel();
-    *(prop->_meshObject) = *(this->_meshObject);
+    prop->_meshObject = this->_meshObject;
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
     aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    resetMeshObject(static_cast<MeshObject*>(prop._meshObject));
     hasSetValue();
 }
+
+const void *PropertyMeshKernel::getSharedData() const
+{
+    return static_cast<const MeshObject*>(_meshObject);
+}
@@ -209,6 +209,10 @@ public:
 
     /** @name Modification */
     //@{
+    /** Returns the mesh object for modification. Copies of this property
+     * share the mesh object until it is modified, so the returned object may
+     * differ from the one returned by getValuePtr() before.
+     */
     MeshObject* startEditing();
     void finishEditing();
     /// Transform the real mesh data
@@ -247,8 +251,19 @@ public:
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
+    const void *getSharedData() const override;
     //@}
 
+private:
+    /// Replaces the referenced mesh object and updates the Python wrapper
+    void resetMeshObject(MeshObject* mesh);
+    /** Makes sure the mesh object is not shared with any copy of this
+     * property before modifying it.
+     * @param copyData: if false, the returned mesh only keeps the placement
+     * because the caller is about to replace the mesh data.
+     */
+    MeshObject* detachMeshObject(bool copyData=true);
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject;
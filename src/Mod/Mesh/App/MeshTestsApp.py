@@ -723,3 +723,36 @@ class MeshProperty(unittest.TestCase):
         self.assertEqual(len(material2["shininess"]), len1 + len2)
         self.assertEqual(len(material2["transparency"]), len1 + len2)
 
+    def testUndoSharedMesh(self):
+        self.doc.UndoMode = 1
+        self.doc.openTransaction("Create")
+        feature = self.doc.addObject("Mesh::Feature", "Mesh")
+        feature.Mesh = Mesh.createSphere(1.0, 50)
+        self.doc.commitTransaction()
+        count = feature.Mesh.CountFacets
+        size1 = self.doc.UndoRedoMemSize
+
+        self.doc.openTransaction("Replace")
+        feature.Mesh = Mesh.createBox(1.0, 1.0, 1.0)
+        self.doc.commitTransaction()
+        size2 = self.doc.UndoRedoMemSize
+        # the undo stack now holds the sphere
+        self.assertGreater(size2, size1)
+
+        # the sphere is shared again by the document and the undo copy, so
+        # only the box on the redo stack is accounted for
+        self.doc.undo()
+        self.assertEqual(feature.Mesh.CountFacets, count)
+        self.assertLess(self.doc.UndoRedoMemSize, size2)
+
+        self.doc.redo()
+        self.assertEqual(feature.Mesh.CountFacets, 12)
+
+        # the oldest undo steps are dropped above the limit
+        self.doc.UndoLimit = 1
+        self.doc.openTransaction("Replace again")
+        feature.Mesh = Mesh.createSphere(1.0, 50)
+        self.doc.commitTransaction()
+        self.assertEqual(self.doc.UndoCount, 1)
+        self.doc.undo()
+        self.assertEqual(feature.Mesh.CountFacets, 12)
@@ -55,6 +55,7 @@
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 #endif
 
+#include <mutex>
 #include <boost/range.hpp>
 typedef boost::iterator_range<const char*> CharRange;
 
@@ -68,6 +69,7 @@ typedef boost::iterator_range<const char*> CharRange;
 #include <App/MappedElement.h>
 #include <App/OriginFeature.h>
 #include <App/Placement.h>
+#include <App/RecomputeProfiler.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Placement.h>
@@ -126,6 +128,12 @@ short Feature::mustExecute() const
     return GeoFeature::mustExecute();
 }
 
+bool Feature::canRecomputeInThread() const
+{
+    // Merging shape contents modifies the content objects
+    return !const_cast<Feature*>(this)->getShapeContentsProperty();
+}
+
 App::DocumentObjectExecReturn *Feature::recompute()
 {
     try {
@@ -1108,13 +1116,15 @@ static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subna
     return shape;
 }
 
-TopoShape Feature::getTopoShape(const App::DocumentObject *obj, const char *subname,
+static TopoShape _getTopoShapeTransformed(const App::DocumentObject *obj, const char *subname,
         bool needSubElement, Base::Matrix4D *pmat, App::DocumentObject **powner,
         bool resolveLink, bool transform, bool noElementMap)
 {
     if(!obj || !obj->getNameInDocument())
         return TopoShape();
 
+    App::RecomputeProfiler::Scope scope("shape", "getTopoShape", obj);
+
     const App::DocumentObject *lastLink=0;
     std::set<std::string> hiddens;
     if(!checkLinkVisibility(hiddens,false,lastLink,obj,subname))
@@ -1191,6 +1201,30 @@ TopoShape Feature::getTopoShape(const App::DocumentObject *obj, const char *subn
 
 }
 
+// Guards the shape caches read by parallel recompute workers
+static std::recursive_mutex _WorkerShapeMutex;
+
+TopoShape Feature::getTopoShape(const App::DocumentObject *obj, const char *subname,
+        bool needSubElement, Base::Matrix4D *pmat, App::DocumentObject **powner,
+        bool resolveLink, bool transform, bool noElementMap)
+{
+    if (!App::Document::isRecomputeWorker())
+        return _getTopoShapeTransformed(obj, subname, needSubElement, pmat,
+                powner, resolveLink, transform, noElementMap);
+
+    // Copies of a shape share the same cache, e.g. the lazily built sub-shape
+    // maps and pending element map, with the shape property of the source
+    // object. So serialize the access, and return a shape with its own cache
+    // for the worker to use freely.
+    std::lock_guard<std::recursive_mutex> lock(_WorkerShapeMutex);
+    auto shape = _getTopoShapeTransformed(obj, subname, needSubElement, pmat,
+            powner, resolveLink, transform, noElementMap);
+    if (!noElementMap)
+        shape.flushElementMap();
+    shape.initCache(1);
+    return shape;
+}
+
 App::DocumentObject *Feature::getShapeOwner(const App::DocumentObject *obj, const char *subname)
 {
     if(!obj)
@@ -71,6 +71,7 @@ public:
     /** @name methods override feature */
     //@{
     short mustExecute() const override;
+    bool canRecomputeInThread() const override;
     //@}
 
     /// returns the type name of the ViewProvider
@@ -61,6 +61,12 @@ public:
     long ParallelRunThreshold;
     bool ValidateShape;
     bool FixShape;
+    bool LazyElementMap;
+    long BooleanCacheSize;
+    long BooleanClusterThreshold;
+    bool LazyRestore;
+    bool SaveTessellation;
+    bool DeduplicateShapes;
     double MinimumDeviation;
     double MeshDeviation;
     double MeshAngularDeflection;
@@ -111,6 +117,18 @@ public:
         funcs["ValidateShape"] = &PartParamsP::updateValidateShape;
         FixShape = handle->GetBool("FixShape", false);
         funcs["FixShape"] = &PartParamsP::updateFixShape;
+        LazyElementMap = handle->GetBool("LazyElementMap", false);
+        funcs["LazyElementMap"] = &PartParamsP::updateLazyElementMap;
+        BooleanCacheSize = handle->GetInt("BooleanCacheSize", 0);
+        funcs["BooleanCacheSize"] = &PartParamsP::updateBooleanCacheSize;
+        BooleanClusterThreshold = handle->GetInt("BooleanClusterThreshold", 0);
+        funcs["BooleanClusterThreshold"] = &PartParamsP::updateBooleanClusterThreshold;
+        LazyRestore = handle->GetBool("LazyRestore", false);
+        funcs["LazyRestore"] = &PartParamsP::updateLazyRestore;
+        SaveTessellation = handle->GetBool("SaveTessellation", false);
+        funcs["SaveTessellation"] = &PartParamsP::updateSaveTessellation;
+        DeduplicateShapes = handle->GetBool("DeduplicateShapes", false);
+        funcs["DeduplicateShapes"] = &PartParamsP::updateDeduplicateShapes;
         MinimumDeviation = handle->GetFloat("MinimumDeviation", 0.05);
         funcs["MinimumDeviation"] = &PartParamsP::updateMinimumDeviation;
         MeshDeviation = handle->GetFloat("MeshDeviation", 0.2);
@@ -218,6 +236,30 @@ public:
         self->FixShape = self->handle->GetBool("FixShape", false);
     }
     // Auto generated code (Tools/params_utils.py:238)
+    static void updateLazyElementMap(PartParamsP *self) {
+        self->LazyElementMap = self->handle->GetBool("LazyElementMap", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateBooleanCacheSize(PartParamsP *self) {
+        self->BooleanCacheSize = self->handle->GetInt("BooleanCacheSize", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateBooleanClusterThreshold(PartParamsP *self) {
+        self->BooleanClusterThreshold = self->handle->GetInt("BooleanClusterThreshold", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateLazyRestore(PartParamsP *self) {
+        self->LazyRestore = self->handle->GetBool("LazyRestore", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateSaveTessellation(PartParamsP *self) {
+        self->SaveTessellation = self->handle->GetBool("SaveTessellation", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateDeduplicateShapes(PartParamsP *self) {
+        self->DeduplicateShapes = self->handle->GetBool("DeduplicateShapes", false);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
     static void updateMinimumDeviation(PartParamsP *self) {
         self->MinimumDeviation = self->handle->GetFloat("MinimumDeviation", 0.05);
     }
@@ -788,6 +830,182 @@ void PartParams::removeFixShape() {
     instance()->handle->RemoveBool("FixShape");
 }
 
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docLazyElementMap() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Delay the generation of the element map of the result of shape operations until\n"
+"its mapped element names are first requested.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getLazyElementMap() {
+    return instance()->LazyElementMap;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultLazyElementMap() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setLazyElementMap(const bool &v) {
+    instance()->handle->SetBool("LazyElementMap",v);
+    instance()->LazyElementMap = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeLazyElementMap() {
+    instance()->handle->RemoveBool("LazyElementMap");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docBooleanCacheSize() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Memory budget in MB for caching the result of boolean operations, keyed by the\n"
+"geometry of the input shapes. The cache is cleared when a document is closed.\n"
+"Set to 0 to disable the cache.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & PartParams::getBooleanCacheSize() {
+    return instance()->BooleanCacheSize;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & PartParams::defaultBooleanCacheSize() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setBooleanCacheSize(const long &v) {
+    instance()->handle->SetInt("BooleanCacheSize",v);
+    instance()->BooleanCacheSize = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeBooleanCacheSize() {
+    instance()->handle->RemoveInt("BooleanCacheSize");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docBooleanClusterThreshold() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Split boolean operations with at least this number of input shapes into clusters\n"
+"of shapes with overlapping bounding boxes, and run the clusters in parallel. Note\n"
+"that this may change the element names of existing models. Set to 0 to disable.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & PartParams::getBooleanClusterThreshold() {
+    return instance()->BooleanClusterThreshold;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & PartParams::defaultBooleanClusterThreshold() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setBooleanClusterThreshold(const long &v) {
+    instance()->handle->SetInt("BooleanClusterThreshold",v);
+    instance()->BooleanClusterThreshold = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeBooleanClusterThreshold() {
+    instance()->handle->RemoveInt("BooleanClusterThreshold");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docLazyRestore() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Keep the shape data read from a document file undecoded, and only decode it when\n"
+"the shape is first accessed.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getLazyRestore() {
+    return instance()->LazyRestore;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultLazyRestore() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setLazyRestore(const bool &v) {
+    instance()->handle->SetBool("LazyRestore",v);
+    instance()->LazyRestore = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeLazyRestore() {
+    instance()->handle->RemoveBool("LazyRestore");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docSaveTessellation() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Save the tessellation of shapes along with the document, so that the shapes can be\n"
+"shown without meshing them again after opening the document.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getSaveTessellation() {
+    return instance()->SaveTessellation;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultSaveTessellation() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setSaveTessellation(const bool &v) {
+    instance()->handle->SetBool("SaveTessellation",v);
+    instance()->SaveTessellation = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeSaveTessellation() {
+    instance()->handle->RemoveBool("SaveTessellation");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docDeduplicateShapes() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Store the shape data only once when saving a document with several identical shapes,\n"
+"and let the other shapes refer to it.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getDeduplicateShapes() {
+    return instance()->DeduplicateShapes;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultDeduplicateShapes() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setDeduplicateShapes(const bool &v) {
+    instance()->handle->SetBool("DeduplicateShapes",v);
+    instance()->DeduplicateShapes = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeDeduplicateShapes() {
+    instance()->handle->RemoveBool("DeduplicateShapes");
+}
+
 // Auto generated code (Tools/params_utils.py:288)
 const char *PartParams::docMinimumDeviation() {
     return "";
@@ -270,6 +270,86 @@ public:
     static const char *docFixShape();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter LazyElementMap
+    ///
+    /// Delay the generation of the element map of the result of shape operations until
+    /// its mapped element names are first requested.
+    static const bool & getLazyElementMap();
+    static const bool & defaultLazyElementMap();
+    static void removeLazyElementMap();
+    static void setLazyElementMap(const bool &v);
+    static const char *docLazyElementMap();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter BooleanCacheSize
+    ///
+    /// Memory budget in MB for caching the result of boolean operations, keyed by the
+    /// geometry of the input shapes. The cache is cleared when a document is closed.
+    /// Set to 0 to disable the cache.
+    static const long & getBooleanCacheSize();
+    static const long & defaultBooleanCacheSize();
+    static void removeBooleanCacheSize();
+    static void setBooleanCacheSize(const long &v);
+    static const char *docBooleanCacheSize();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter BooleanClusterThreshold
+    ///
+    /// Split boolean operations with at least this number of input shapes into clusters
+    /// of shapes with overlapping bounding boxes, and run the clusters in parallel. Note
+    /// that this may change the element names of existing models. Set to 0 to disable.
+    static const long & getBooleanClusterThreshold();
+    static const long & defaultBooleanClusterThreshold();
+    static void removeBooleanClusterThreshold();
+    static void setBooleanClusterThreshold(const long &v);
+    static const char *docBooleanClusterThreshold();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter LazyRestore
+    ///
+    /// Keep the shape data read from a document file undecoded, and only decode it when
+    /// the shape is first accessed.
+    static const bool & getLazyRestore();
+    static const bool & defaultLazyRestore();
+    static void removeLazyRestore();
+    static void setLazyRestore(const bool &v);
+    static const char *docLazyRestore();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter SaveTessellation
+    ///
+    /// Save the tessellation of shapes along with the document, so that the shapes can be
+    /// shown without meshing them again after opening the document.
+    static const bool & getSaveTessellation();
+    static const bool & defaultSaveTessellation();
+    static void removeSaveTessellation();
+    static void setSaveTessellation(const bool &v);
+    static const char *docSaveTessellation();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter DeduplicateShapes
+    ///
+    /// Store the shape data only once when saving a document with several identical shapes,
+    /// and let the other shapes refer to it.
+    static const bool & getDeduplicateShapes();
+    static const bool & defaultDeduplicateShapes();
+    static void removeDeduplicateShapes();
+    static void setDeduplicateShapes(const bool &v);
+    static const char *docDeduplicateShapes();
+    //@}
+
     // Auto generated code (Tools/params_utils.py:122)
     //@{
     /// Accessor for parameter MinimumDeviation
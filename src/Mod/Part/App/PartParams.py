@@ -76,6 +76,26 @@ Params = [
     ParamInt("ParallelRunThreshold", 100),
     ParamBool("ValidateShape", True),
     ParamBool("FixShape", False),
+    ParamBool("LazyElementMap", False, doc=\
+        "Delay the generation of the element map of the result of shape operations until\n"
+        "its mapped element names are first requested."),
+    ParamInt("BooleanCacheSize", 0, doc=\
+        "Memory budget in MB for caching the result of boolean operations, keyed by the\n"
+        "geometry of the input shapes. The cache is cleared when a document is closed.\n"
+        "Set to 0 to disable the cache."),
+    ParamInt("BooleanClusterThreshold", 0, doc=\
+        "Split boolean operations with at least this number of input shapes into clusters\n"
+        "of shapes with overlapping bounding boxes, and run the clusters in parallel. Note\n"
+        "that this may change the element names of existing models. Set to 0 to disable."),
+    ParamBool("LazyRestore", False, doc=\
+        "Keep the shape data read from a document file undecoded, and only decode it when\n"
+        "the shape is first accessed."),
+    ParamBool("SaveTessellation", False, doc=\
+        "Save the tessellation of shapes along with the document, so that the shapes can be\n"
+        "shown without meshing them again after opening the document."),
+    ParamBool("DeduplicateShapes", False, doc=\
+        "Store the shape data only once when saving a document with several identical shapes,\n"
+        "and let the other shapes refer to it."),
     _MinimumDeviation,
     _MeshDeviation,
     _MeshAngularDeflection,
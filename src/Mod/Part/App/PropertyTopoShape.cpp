@@ -25,12 +25,20 @@
 #ifndef _PreComp_
 # include <sstream>
 # include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRep_Tool.hxx>
 # include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepTools.hxx>
 # include <BRepTools_ShapeSet.hxx>
 # include <OSD_OpenFile.hxx>
+# include <Poly_PolygonOnTriangulation.hxx>
+# include <Poly_Triangulation.hxx>
+# include <TColStd_Array1OfInteger.hxx>
+# include <TColStd_Array1OfReal.hxx>
 # include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <Standard_Failure.hxx>
 # include <Standard_Version.hxx>
 # include <gp_GTrsf.hxx>
@@ -41,6 +49,13 @@
 # include <TopoDS.hxx>
 #endif // _PreComp_
 
+#include <mutex>
+#include <set>
+#include <QCryptographicHash>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
@@ -63,6 +78,7 @@
 #include "TopoShapePy.h"
 
 namespace bp = boost::placeholders;
+namespace bio = boost::iostreams;
 
 FC_LOG_LEVEL_INIT("PropShape",true,true);
 
@@ -78,6 +94,411 @@ PropertyPartShape::~PropertyPartShape()
 {
 }
 
+static ParameterGrp::handle getGeneralParameters()
+{
+    static ParameterGrp::handle hGrp;
+    if (!hGrp)
+        hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+    return hGrp;
+}
+
+static std::mutex _PendingShapeMutex;
+
+// Marks a file that refers to another file with identical content, see SaveDocFile()
+static const char _SharedShapeMarker[] = "FreeCAD_SharedShape";
+
+// Tessellation saved along with the shape when parameter SaveTessellation is
+// set, see SaveDocFile(). It contains the triangulation of each face, and the
+// polygons of its edges on the triangulation. Faces and edges are indexed as
+// in TopExp::MapShapes(), so that they can be reattached to the restored shape.
+static const uint32_t _TessellationMagic = 0x4853454d; // "MESH"
+static const uint32_t _TessellationVersion = 1;
+
+namespace {
+struct EdgePolygon {
+    int edge;
+    Handle(Poly_PolygonOnTriangulation) polygon;
+    // polygon of the reversed seam edge
+    Handle(Poly_PolygonOnTriangulation) polygon2;
+};
+
+struct FaceTriangulation {
+    Handle(Poly_Triangulation) mesh;
+    std::vector<EdgePolygon> polygons;
+};
+} // anonymous namespace
+
+static bool hasTriangulation(const TopoDS_Shape &shape)
+{
+    TopLoc_Location loc;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (!BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull())
+            return true;
+    }
+    return false;
+}
+
+// Digest of the tessellation of the shape. Meshing a shape again, e.g. with a
+// different deflection, does not touch the property, so this is used to check
+// whether the previously saved tessellation is still up to date.
+static std::size_t tessellationStamp(const TopoDS_Shape &shape)
+{
+    std::size_t seed = 0;
+    auto combine = [&seed](std::size_t v) {
+        seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    TopLoc_Location loc;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc);
+        if (mesh.IsNull()) {
+            combine(0);
+            continue;
+        }
+        combine(std::hash<int>()(mesh->NbNodes()));
+        combine(std::hash<int>()(mesh->NbTriangles()));
+        combine(std::hash<double>()(mesh->Deflection()));
+    }
+    return seed;
+}
+
+// Check the header of tessellation data read from a file
+static bool isTessellationData(const std::string &data)
+{
+    bio::stream<bio::array_source> in(data.data(), data.size());
+    Base::InputStream str(in);
+    uint32_t magic = 0, version = 0;
+    str >> magic >> version;
+    return in && magic == _TessellationMagic && version == _TessellationVersion;
+}
+
+static void writePolygon(Base::OutputStream &str, const Handle(Poly_PolygonOnTriangulation) &polygon)
+{
+    const TColStd_Array1OfInteger &nodes = polygon->Nodes();
+    str << (uint32_t)nodes.Length() << polygon->Deflection();
+    for (int i=nodes.Lower(); i<=nodes.Upper(); ++i)
+        str << (uint32_t)nodes(i);
+    bool hasParameters = polygon->HasParameters();
+    str << hasParameters;
+    if (hasParameters) {
+        const TColStd_Array1OfReal &params = polygon->Parameters()->Array1();
+        for (int i=params.Lower(); i<=params.Upper(); ++i)
+            str << params(i);
+    }
+}
+
+static void writeTriangulation(std::ostream &out, const TopoDS_Shape &shape)
+{
+    Base::OutputStream str(out);
+    TopTools_IndexedMapOfShape faceMap, edgeMap;
+    if (!shape.IsNull()) {
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    }
+    str << _TessellationMagic << _TessellationVersion
+        << (uint32_t)faceMap.Extent() << (uint32_t)edgeMap.Extent();
+
+    for (int i=1; i<=faceMap.Extent(); ++i) {
+        const TopoDS_Face &face = TopoDS::Face(faceMap(i));
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+        if (mesh.IsNull()) {
+            str << (uint32_t)0;
+            continue;
+        }
+        bool hasUV = mesh->HasUVNodes();
+        str << (uint32_t)mesh->NbNodes() << (uint32_t)mesh->NbTriangles()
+            << mesh->Deflection() << hasUV;
+        for (int j=1; j<=mesh->NbNodes(); ++j) {
+#if OCC_VERSION_HEX < 0x070600
+            const gp_Pnt &pnt = mesh->Nodes()(j);
+#else
+            gp_Pnt pnt = mesh->Node(j);
+#endif
+            str << pnt.X() << pnt.Y() << pnt.Z();
+            if (hasUV) {
+#if OCC_VERSION_HEX < 0x070600
+                const gp_Pnt2d &uv = mesh->UVNodes()(j);
+#else
+                gp_Pnt2d uv = mesh->UVNode(j);
+#endif
+                str << uv.X() << uv.Y();
+            }
+        }
+        for (int j=1; j<=mesh->NbTriangles(); ++j) {
+            Standard_Integer n1, n2, n3;
+#if OCC_VERSION_HEX < 0x070600
+            mesh->Triangles()(j).Get(n1, n2, n3);
+#else
+            mesh->Triangle(j).Get(n1, n2, n3);
+#endif
+            str << (uint32_t)n1 << (uint32_t)n2 << (uint32_t)n3;
+        }
+
+        std::vector<EdgePolygon> polygons;
+        std::set<int> edges;
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            int idx = edgeMap.FindIndex(xp.Current());
+            if (!edges.insert(idx).second)
+                continue;
+            const TopoDS_Edge &edge = TopoDS::Edge(xp.Current());
+            EdgePolygon info;
+            info.edge = idx;
+            info.polygon = BRep_Tool::PolygonOnTriangulation(
+                    TopoDS::Edge(edge.Oriented(TopAbs_FORWARD)), mesh, loc);
+            if (info.polygon.IsNull())
+                continue;
+            info.polygon2 = BRep_Tool::PolygonOnTriangulation(
+                    TopoDS::Edge(edge.Oriented(TopAbs_REVERSED)), mesh, loc);
+            if (info.polygon2 == info.polygon)
+                info.polygon2.Nullify();
+            polygons.push_back(info);
+        }
+        str << (uint32_t)polygons.size();
+        for (auto &info : polygons) {
+            str << (uint32_t)info.edge << !info.polygon2.IsNull();
+            writePolygon(str, info.polygon);
+            if (!info.polygon2.IsNull())
+                writePolygon(str, info.polygon2);
+        }
+    }
+}
+
+static Handle(Poly_PolygonOnTriangulation) readPolygon(Base::InputStream &str,
+                                                       std::istream &in,
+                                                       uint32_t maxCount,
+                                                       uint32_t nbNodes)
+{
+    Handle(Poly_PolygonOnTriangulation) polygon;
+    uint32_t count = 0;
+    double deflection = 0.0;
+    str >> count >> deflection;
+    if (!in || count == 0 || count > maxCount)
+        return polygon;
+    TColStd_Array1OfInteger nodes(1, count);
+    for (int i=1; i<=(int)count; ++i) {
+        uint32_t node = 0;
+        str >> node;
+        if (node == 0 || node > nbNodes)
+            return polygon;
+        nodes(i) = node;
+    }
+    bool hasParameters = false;
+    str >> hasParameters;
+    if (hasParameters) {
+        TColStd_Array1OfReal params(1, count);
+        for (int i=1; i<=(int)count; ++i) {
+            double param = 0.0;
+            str >> param;
+            params(i) = param;
+        }
+        polygon = new Poly_PolygonOnTriangulation(nodes, params);
+    }
+    else
+        polygon = new Poly_PolygonOnTriangulation(nodes);
+    polygon->Deflection(deflection);
+    if (!in)
+        polygon.Nullify();
+    return polygon;
+}
+
+/** Attach the saved tessellation to the faces and edges of the shape
+ *
+ * @return Returns false if the data does not match the shape. Nothing is
+ * attached in this case.
+ */
+static bool readTriangulation(const std::string &data, const TopoDS_Shape &shape)
+{
+    bio::stream<bio::array_source> in(data.data(), data.size());
+    Base::InputStream str(in);
+    // Sanity limit of any count read from the data
+    uint32_t maxCount = static_cast<uint32_t>(std::min<std::size_t>(data.size(), UINT32_MAX));
+
+    uint32_t magic = 0, version = 0, nbFaces = 0, nbEdges = 0;
+    str >> magic >> version >> nbFaces >> nbEdges;
+    TopTools_IndexedMapOfShape faceMap, edgeMap;
+    if (!shape.IsNull()) {
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    }
+    if (!in || magic != _TessellationMagic || version != _TessellationVersion
+            || nbFaces != (uint32_t)faceMap.Extent() || nbEdges != (uint32_t)edgeMap.Extent())
+        return false;
+
+    std::vector<FaceTriangulation> faces(nbFaces);
+    for (auto &info : faces) {
+        uint32_t nbNodes = 0, nbTriangles = 0;
+        double deflection = 0.0;
+        bool hasUV = false;
+        str >> nbNodes;
+        if (!in)
+            return false;
+        if (nbNodes == 0)
+            continue;
+        str >> nbTriangles >> deflection >> hasUV;
+        if (!in || nbNodes > maxCount || nbTriangles > maxCount)
+            return false;
+
+        Handle(Poly_Triangulation) mesh = new Poly_Triangulation(nbNodes, nbTriangles, hasUV);
+        mesh->Deflection(deflection);
+        for (int j=1; j<=(int)nbNodes; ++j) {
+            double x = 0.0, y = 0.0, z = 0.0;
+            str >> x >> y >> z;
+#if OCC_VERSION_HEX < 0x070600
+            mesh->ChangeNodes().SetValue(j, gp_Pnt(x, y, z));
+#else
+            mesh->SetNode(j, gp_Pnt(x, y, z));
+#endif
+            if (hasUV) {
+                double u = 0.0, v = 0.0;
+                str >> u >> v;
+#if OCC_VERSION_HEX < 0x070600
+                mesh->ChangeUVNodes().SetValue(j, gp_Pnt2d(u, v));
+#else
+                mesh->SetUVNode(j, gp_Pnt2d(u, v));
+#endif
+            }
+        }
+        for (int j=1; j<=(int)nbTriangles; ++j) {
+            uint32_t n1 = 0, n2 = 0, n3 = 0;
+            str >> n1 >> n2 >> n3;
+            if (n1 == 0 || n1 > nbNodes || n2 == 0 || n2 > nbNodes || n3 == 0 || n3 > nbNodes)
+                return false;
+#if OCC_VERSION_HEX < 0x070600
+            mesh->ChangeTriangles().SetValue(j, Poly_Triangle(n1, n2, n3));
+#else
+            mesh->SetTriangle(j, Poly_Triangle(n1, n2, n3));
+#endif
+        }
+        info.mesh = mesh;
+
+        uint32_t nbPolygons = 0;
+        str >> nbPolygons;
+        if (!in || nbPolygons > nbEdges)
+            return false;
+        info.polygons.resize(nbPolygons);
+        for (auto &polygon : info.polygons) {
+            uint32_t edge = 0;
+            bool hasPolygon2 = false;
+            str >> edge >> hasPolygon2;
+            if (!in || edge == 0 || edge > nbEdges)
+                return false;
+            polygon.edge = edge;
+            polygon.polygon = readPolygon(str, in, maxCount, nbNodes);
+            if (polygon.polygon.IsNull())
+                return false;
+            if (hasPolygon2) {
+                polygon.polygon2 = readPolygon(str, in, maxCount, nbNodes);
+                if (polygon.polygon2.IsNull())
+                    return false;
+            }
+        }
+    }
+
+    BRep_Builder builder;
+    for (int i=1; i<=faceMap.Extent(); ++i) {
+        auto &info = faces[i-1];
+        if (info.mesh.IsNull())
+            continue;
+        const TopoDS_Face &face = TopoDS::Face(faceMap(i));
+        builder.UpdateFace(face, info.mesh);
+        for (auto &polygon : info.polygons) {
+            const TopoDS_Edge &edge = TopoDS::Edge(edgeMap(polygon.edge));
+            if (polygon.polygon2.IsNull())
+                builder.UpdateEdge(edge, polygon.polygon, info.mesh, face.Location());
+            else
+                builder.UpdateEdge(edge, polygon.polygon, polygon.polygon2, info.mesh, face.Location());
+        }
+    }
+    return true;
+}
+
+void PropertyPartShape::restorePendingShape() const
+{
+    if (!_HasPendingShape)
+        return;
+
+    std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+    if (!_PendingShape)
+        return;
+    auto pending = std::move(_PendingShape);
+    bio::stream<bio::array_source> stream(pending->data.data(), pending->data.size());
+    Base::Reader reader(stream, pending->fileName);
+
+    auto self = const_cast<PropertyPartShape*>(this);
+    TopoShape shape = self->readShape(reader, true);
+    // The shape is considered as restored already, so do not signal any change
+    self->setRestoredShape(shape, false);
+    _HasPendingShape = false;
+    attachTessellation();
+}
+
+void PropertyPartShape::discardPendingShape()
+{
+    if (!_HasPendingShape)
+        return;
+    std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+    _PendingShape.reset();
+    _PendingTessellation.clear();
+    _HasPendingShape = false;
+}
+
+bool PropertyPartShape::hasTessellation() const
+{
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        if (_PendingShape)
+            return isTessellationData(_PendingTessellation);
+    }
+    return hasTriangulation(_Shape.getShape());
+}
+
+void PropertyPartShape::writeTessellation(std::ostream &out) const
+{
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        // Not decoded yet, write back the original content. It is checked by
+        // hasTessellation() before adding the file, see Save().
+        if (_PendingShape && isTessellationData(_PendingTessellation)) {
+            out.write(_PendingTessellation.data(), _PendingTessellation.size());
+            return;
+        }
+    }
+    writeTriangulation(out, _Shape.getShape());
+    _TessellationStamp = tessellationStamp(_Shape.getShape());
+}
+
+void PropertyPartShape::setPendingTessellation(std::string &&data)
+{
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        if (_PendingShape) {
+            // Attach on decoding the shape, see restorePendingShape()
+            _PendingTessellation = std::move(data);
+            return;
+        }
+    }
+    _PendingTessellation = std::move(data);
+    attachTessellation();
+}
+
+void PropertyPartShape::attachTessellation() const
+{
+    if (_PendingTessellation.empty())
+        return;
+    std::string data;
+    data.swap(_PendingTessellation);
+    try {
+        if (!readTriangulation(data, _Shape.getShape()))
+            FC_WARN("Discard mismatched tessellation of " << getFullName());
+        else
+            _TessellationStamp = tessellationStamp(_Shape.getShape());
+    }
+    catch (Standard_Failure &e) {
+        FC_WARN("Failed to restore tessellation of " << getFullName() << ": " << e.GetMessageString());
+    }
+}
+
 void PropertyPartShape::validateShape(App::DocumentObject *obj)
 {
     if (!obj || !obj->getDocument()
@@ -106,6 +527,7 @@ void PropertyPartShape::validateShape(App::DocumentObject *obj)
 
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
+    discardPendingShape();
     aboutToSetValue();
     _Shape = sh;
     auto obj = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
@@ -128,6 +550,7 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
+    discardPendingShape();
     aboutToSetValue();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
@@ -140,11 +563,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue(void)const
 {
+    restorePendingShape();
     return _Shape.getShape();
 }
 
 TopoShape PropertyPartShape::getShape() const
 {
+    restorePendingShape();
     _Shape.initCache(-1);
     auto res = _Shape;
     if (Feature::isElementMappingDisabled(getContainer()))
@@ -158,12 +583,14 @@ TopoShape PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    restorePendingShape();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    restorePendingShape();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -190,16 +617,21 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    restorePendingShape();
     _Shape.setTransform(rclTrf);
+    // changed without touch(), so the saved file is no longer up to date
+    setStatus(Saved, false);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    restorePendingShape();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    restorePendingShape();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -241,6 +673,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    restorePendingShape();
     PropertyPartShape *prop = new PropertyPartShape();
 
     if (PartParams::getShapePropertyCopy()) {
@@ -256,6 +689,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = Base::freecad_dynamic_cast<const PropertyPartShape>(&from);
     if(prop) {
+        prop->restorePendingShape();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -263,9 +697,33 @@ void PropertyPartShape::Paste(const App::Property &from)
 
 unsigned int PropertyPartShape::getMemSize (void) const
 {
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        if (_PendingShape)
+            return _Shape.getMemSize() + static_cast<unsigned int>(_PendingShape->data.size());
+    }
     return _Shape.getMemSize();
 }
 
+void PropertyPartShape::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    // Do not use getComplexData(), which would restore the pending shape
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        if (_PendingShape)
+            sizes["PendingShape"] += _PendingShape->data.size();
+    }
+    _Shape.getMemSizeDetails(sizes);
+}
+
+const void *PropertyPartShape::getSharedData() const
+{
+    // Copy() shares the TopoDS_TShape unless ShapePropertyCopy is set
+    if (_HasPendingShape || _Shape.isNull())
+        return nullptr;
+    return _Shape.getShape().TShape().get();
+}
+
 void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) const
 {
     // The paths below seem to only there for expression completer. They are no
@@ -289,7 +747,13 @@ void PropertyPartShape::beforeSave() const
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
-    if(owner && !_Shape.isNull() && _Shape.getElementMapSize()>0) {
+    // A shape pending for lazy restore still has its element map
+    bool hasShape = _HasPendingShape || !_Shape.isNull();
+    // A lazy element map is only generated below, so do not reuse the
+    // previously saved element map file for it
+    if (_Shape.hasPendingElementMap() && testStatus(Saved))
+        const_cast<PropertyPartShape*>(this)->setStatus(Saved, false);
+    if(owner && hasShape && _Shape.getElementMapSize()>0) {
         auto ret = owner->getDocument()->addStringHasher(_Shape.Hasher);
         _HasherIndex = ret.second;
         _SaveHasher = ret.first;
@@ -302,7 +766,8 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     //See SaveDocFile(), RestoreDocFile()
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
-    if(owner && !_Shape.isNull()
+    bool hasShape = _HasPendingShape || !_Shape.isNull();
+    if(owner && hasShape
              && _Shape.getElementMapSize()>0
              && !_Shape.Hasher.isNull()) {
         writer.Stream() << " HasherIndex=\"" << _HasherIndex << '"';
@@ -322,15 +787,24 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     bool toXML = writer.getFileVersion()>1 && writer.isForceXML()>=(binary?3:2);
     if(!toXML) {
         writer.Stream() << " file=\""
-            << writer.addFile(getFileName(binary?".bin":".brp"), this)
-            << "\"/>\n";
+            << writer.addFile(getFileName(binary?".bin":".brp"), this) << '"';
+        if (PartParams::getSaveTessellation() && hasTessellation()) {
+            // Do not reuse the previously saved file if meshed again since then
+            if (!_HasPendingShape && testStatus(Saved)
+                    && _TessellationStamp != tessellationStamp(_Shape.getShape()))
+                const_cast<PropertyPartShape*>(this)->setStatus(Saved, false);
+            writer.Stream() << " mesh=\"" << writer.addFile(getFileName(".Mesh"), this) << '"';
+        }
+        writer.Stream() << "/>\n";
     } else if(binary) {
+        restorePendingShape();
         writer.Stream() << " binary=\"1\">\n";
         TopoShape shape;
         shape.setShape(_Shape.getShape());
         shape.exportBinary(writer.beginCharStream(true));
         writer.endCharStream() <<  writer.ind() << "</Part>\n";
     } else {
+        restorePendingShape();
         writer.Stream() << " brep=\"1\">\n";
         _Shape.exportBrep(writer.beginCharStream(false)<<'\n');
         writer.endCharStream() << '\n' << writer.ind() << "</Part>\n";
@@ -360,6 +834,8 @@ std::string PropertyPartShape::getElementMapVersion(bool restored) const {
 
 void PropertyPartShape::Restore(Base::XMLReader &reader)
 {
+    discardPendingShape();
+    _PendingTessellation.clear();
     reader.readElement("Part");
 
     auto owner = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
@@ -379,6 +855,10 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
             // initiate a file read
             reader.addFile(file.c_str(),this);
         }
+        // optional tessellation saved after the shape, see SaveDocFile()
+        std::string mesh = reader.getAttribute("mesh", "");
+        if (!mesh.empty())
+            reader.addFile(mesh.c_str(),this);
     } else if(reader.getAttributeAsInteger("binary","")) {
         TopoShape shape;
         shape.importBinary(reader.beginCharStream(true));
@@ -611,63 +1091,188 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
     // if (_Shape.getShape().IsNull())
     //     return;
 
-    TopoDS_Shape myShape = _Shape.getShape();
     Base::FileInfo finfo(writer.getCurrentFileName());
-    if (finfo.hasExtension("bin")) {
-        TopoShape shape;
-        shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+    if (finfo.hasExtension("Mesh")) {
+        writeTessellation(writer.Stream());
+        return;
+    }
+    bool binary = finfo.hasExtension("bin");
+    auto hGrp = getGeneralParameters();
+
+    if (PartParams::getDeduplicateShapes()) {
+        // Serialize into memory first to check for identical content saved
+        // earlier, in which case only a reference to that file is written.
+        std::ostringstream ss;
+        ss.imbue(std::locale::classic());
+        writeShape(ss, binary);
+        std::string data = ss.str();
+        QByteArray hash = QCryptographicHash::hash(
+                QByteArray::fromRawData(data.c_str(), static_cast<int>(data.size())),
+                QCryptographicHash::Sha1);
+        std::ostringstream key;
+        key << finfo.extension() << ':' << data.size() << ':' << hash.toHex().constData();
+        std::string file = writer.registerFileContent(key.str());
+        if (!file.empty())
+            writer.Stream() << _SharedShapeMarker << ' ' << file << '\n';
+        else
+            writer.Stream().write(data.c_str(), data.size());
+        return;
+    }
+
+    if (binary || _HasPendingShape || hGrp->GetBool("DirectAccess", true)) {
+        writeShape(writer.Stream(), binary);
     }
     else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
-        if (!direct) {
-            saveToFile(writer);
-        }
-        else {
-            TopoShape shape;
-            shape.setShape(myShape);
-            shape.exportBrep(writer.Stream());
+        saveToFile(writer);
+    }
+}
+
+void PropertyPartShape::writeShape(std::ostream &out, bool binary) const
+{
+    if (_HasPendingShape) {
+        std::lock_guard<std::mutex> lock(_PendingShapeMutex);
+        if (_PendingShape && Base::FileInfo(_PendingShape->fileName).hasExtension(binary?"bin":"brp")) {
+            // Not decoded yet, write back the original content
+            out.write(_PendingShape->data.data(), _PendingShape->data.size());
+            return;
         }
     }
+    restorePendingShape();
+
+    TopoShape shape;
+    shape.setShape(_Shape.getShape());
+    if (binary)
+        shape.exportBinary(out);
+    else
+        shape.exportBrep(out);
 }
 
-void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
+bool PropertyPartShape::readSharedFile(Base::Reader &reader, std::string &file)
 {
-    // save the element map
-    auto elementMap = _Shape.resetElementMap();
-    auto hasher = _Shape.Hasher;
+    if (reader.peek() != _SharedShapeMarker[0])
+        return false;
+    std::string marker;
+    reader >> marker >> file;
+    return marker == _SharedShapeMarker;
+}
+
+void PropertyPartShape::restoreSharedShape(Base::XMLReader *reader,
+                                           const std::string &file,
+                                           const std::string &sharedBy)
+{
+    auto prop = reader ? dynamic_cast<PropertyPartShape*>(reader->getFileObject(file)) : nullptr;
+    if (!prop || prop == this) {
+        FC_ERR("Shared shape file '" << file << "' not found for " << getFullName());
+        return;
+    }
+    reader->addSharedFile(file);
+    reader->addSharedFile(sharedBy);
+    // Share the same TopoDS_TShape with the other property
+    prop->restorePendingShape();
+    TopoShape shape;
+    shape.setShape(prop->_Shape.getShape());
+    setRestoredShape(shape);
+}
 
+TopoShape PropertyPartShape::readShape(Base::Reader &reader, bool direct)
+{
     Base::FileInfo brep(reader.getFileName());
     TopoShape shape;
     if (brep.hasExtension("bin")) {
         shape.importBinary(reader);
     }
+    else if (!direct) {
+        shape = loadFromFile(reader);
+    }
     else {
-        TopoDS_Shape sh;
-        static ParameterGrp::handle hGrp;
-        if (!hGrp)
-            hGrp = App::GetApplication().GetParameterGroupByPath(
-                "User parameter:BaseApp/Preferences/Mod/Part/General");
-        bool direct = hGrp->GetBool("DirectAccess", true);
-        if (!direct) {
-            shape = loadFromFile(reader);
-        }
-        else {
-            auto iostate = reader.exceptions();
-            shape = loadFromStream(reader);
-            reader.exceptions(iostate);
-        }
+        auto iostate = reader.exceptions();
+        shape = loadFromStream(reader);
+        reader.exceptions(iostate);
     }
+    return shape;
+}
+
+void PropertyPartShape::setRestoredShape(TopoShape &shape, bool notify)
+{
+    // save the element map
+    auto elementMap = _Shape.resetElementMap();
+    auto hasher = _Shape.Hasher;
 
     std::string ver = _Ver;
     // restore the element map
     shape.Hasher = hasher;
     shape.resetElementMap(elementMap);
-    setValue(shape);
+    if (notify)
+        setValue(shape);
+    else {
+        if (auto owner = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer()))
+            shape.Tag = owner->getID();
+        _Shape = shape;
+    }
     _Ver = ver;
 }
 
+void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
+{
+    if (Base::FileInfo(reader.getFileName()).hasExtension("Mesh")) {
+        setPendingTessellation(std::string(std::istreambuf_iterator<char>(reader), {}));
+        return;
+    }
+
+    discardPendingShape();
+
+    std::string file;
+    if (readSharedFile(reader, file)) {
+        restoreSharedShape(reader.getParent(), file, reader.getFileName());
+        return;
+    }
+
+    auto hGrp = getGeneralParameters();
+    if (PartParams::getLazyRestore()) {
+        // Keep the file content, and only decode it on first access
+        std::unique_ptr<PendingShape> pending(new PendingShape);
+        pending->fileName = reader.getFileName();
+        pending->data.assign(std::istreambuf_iterator<char>(reader), {});
+        _PendingShape = std::move(pending);
+        _HasPendingShape = true;
+        return;
+    }
+
+    TopoShape shape = readShape(reader, hGrp->GetBool("DirectAccess", true));
+    setRestoredShape(shape);
+}
+
+bool PropertyPartShape::canRestoreDocFileInThread() const
+{
+    // Lazy restore does not decode anything, and loading through temporary
+    // file is not meant to run concurrently.
+    auto hGrp = getGeneralParameters();
+    return !PartParams::getLazyRestore() && hGrp->GetBool("DirectAccess", true);
+}
+
+std::function<void()> PropertyPartShape::RestoreDocFileInThread(Base::Reader &reader)
+{
+    if (Base::FileInfo(reader.getFileName()).hasExtension("Mesh")) {
+        auto data = std::make_shared<std::string>(std::istreambuf_iterator<char>(reader),
+                                                  std::istreambuf_iterator<char>());
+        return [this, data]() {
+            setPendingTessellation(std::move(*data));
+        };
+    }
+    std::string file;
+    if (readSharedFile(reader, file)) {
+        auto parent = reader.getParent();
+        std::string sharedBy = reader.getFileName();
+        return [this, parent, file, sharedBy]() {
+            restoreSharedShape(parent, file, sharedBy);
+        };
+    }
+    auto shape = std::make_shared<TopoShape>(readShape(reader, true));
+    return [this, shape]() {
+        setRestoredShape(*shape);
+    };
+}
+
 // -------------------------------------------------------------------------
 
 ShapeHistory::ShapeHistory(BRepBuilderAPI_MakeShape& mkShape, TopAbs_ShapeEnum type,
@@ -991,7 +1596,8 @@ bool PropertyShapeCache::getShape(const App::DocumentObject *obj, TopoShape &sha
 void PropertyShapeCache::setShape(
         const App::DocumentObject *obj, const TopoShape &shape, const char *subname) 
 {
-    if (PartParams::getDisableShapeCache())
+    // Do not modify other objects from a parallel recompute worker
+    if (PartParams::getDisableShapeCache() || App::Document::isRecomputeWorker())
         return;
     auto prop = get(obj,true);
     if(!prop)
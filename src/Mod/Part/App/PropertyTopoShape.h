@@ -23,12 +23,12 @@
 #ifndef PART_PROPERTYTOPOSHAPE_H
 #define PART_PROPERTYTOPOSHAPE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 
 class BRepBuilderAPI_MakeShape;
-#include <map>
-#include <vector>
 
 #include "TopoShape.h"
 #include <TopAbs_ShapeEnum.hxx>
@@ -96,9 +96,14 @@ public:
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
 
+    bool canRestoreDocFileInThread() const override;
+    std::function<void()> RestoreDocFileInThread(Base::Reader &reader) override;
+
     App::Property *Copy(void) const override;
     void Paste(const App::Property &from) override;
     unsigned int getMemSize (void) const override;
+    void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const override;
+    const void *getSharedData() const override;
     //@}
 
     /// Get valid paths for this property; used by auto completer
@@ -118,12 +123,39 @@ private:
     void saveToFile(Base::Writer &writer) const;
     TopoDS_Shape loadFromFile(Base::Reader &reader);
     TopoDS_Shape loadFromStream(Base::Reader &reader);
+    TopoShape readShape(Base::Reader &reader, bool direct);
+    void writeShape(std::ostream &out, bool binary) const;
+    static bool readSharedFile(Base::Reader &reader, std::string &file);
+    void restoreSharedShape(Base::XMLReader *reader, const std::string &file,
+                            const std::string &sharedBy);
+    void setRestoredShape(TopoShape &shape, bool notify=true);
+    /// Decode the shape data kept by lazy restore
+    void restorePendingShape() const;
+    void discardPendingShape();
+    /// Check if there is any face triangulation to save
+    bool hasTessellation() const;
+    void writeTessellation(std::ostream &out) const;
+    void setPendingTessellation(std::string &&data);
+    /// Attach the restored triangulation to the shape
+    void attachTessellation() const;
 
 private:
     TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+
+    /// Undecoded file content for lazy restore
+    struct PendingShape {
+        std::string fileName;
+        std::string data;
+    };
+    mutable std::unique_ptr<PendingShape> _PendingShape;
+    mutable std::atomic<bool> _HasPendingShape{false};
+    /// Saved tessellation waiting for the shape to be restored
+    mutable std::string _PendingTessellation;
+    /// Digest of the tessellation last saved or restored
+    mutable std::size_t _TessellationStamp = 0;
 };
 
 struct PartExport ShapeHistory {
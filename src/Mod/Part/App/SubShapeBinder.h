@@ -104,6 +104,9 @@ public:
 
     virtual bool canLinkProperties() const override {return false;}
 
+    /// The binder may copy the bound objects on recompute
+    virtual bool canRecomputeInThread() const override {return false;}
+
     virtual App::DocumentObject *getSubObject(const char *subname, PyObject **pyObj=0, 
             Base::Matrix4D *mat=0, bool transform=true, int depth=0) const override;
 
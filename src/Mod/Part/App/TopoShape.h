@@ -233,6 +233,7 @@ public:
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
     unsigned int getMemSize () const override;
+    void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const override;
     //@}
 
     /** @name Input/Output */
@@ -269,6 +270,19 @@ public:
     bool isLinearEdge(Base::Vector3d *dir = nullptr, Base::Vector3d *base = nullptr) const;
     /// Check if this shape is a single planar face, works on BSplineSurface and BezierSurface
     bool isPlanarFace(double tol=1e-7) const;
+    /** Return a digest of the geometry, topology and placement of the shape
+     *
+     * Shapes with the same digest are geometrically identical. The element
+     * map is not included.
+     */
+    std::string getGeometryHash() const;
+    /** Return an object identifying the content of the element map
+     *
+     * Shapes returning the same object have the same element map. Unlike
+     * getElementMap(), this does not generate any pending element map.
+     * Holding the returned object keeps its identity from being reused.
+     */
+    std::shared_ptr<const void> getElementMapIdentity() const;
     //@}
 
     /** @name Boolean operation*/
@@ -2489,6 +2503,12 @@ public:
     friend class Cache;
 
 protected:
+    /// Record the shape history for generating the element map on first access
+    bool delayElementMap(const Mapper &mapper, const std::vector<TopoShape> &sources, const char *op);
+
+    /// Generate mapped element names of the current shape from shape history
+    void generateElementMap(const Mapper &mapper, const std::vector<TopoShape> &sources, const char *op);
+
     virtual Data::MappedName renameDuplicateElement(int index,
                                                     const Data::IndexedName & element, 
                                                     const Data::IndexedName & element2,
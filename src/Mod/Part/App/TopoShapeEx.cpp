@@ -144,6 +144,7 @@
 # include <Geom_ToroidalSurface.hxx>
 # include <GeomLib_IsPlanarSurface.hxx>
 # include <GeomConvert.hxx>
+# include <Poly_Polygon3D.hxx>
 # include <Poly_Triangulation.hxx>
 # include <Standard_Failure.hxx>
 # include <StlAPI_Writer.hxx>
@@ -187,6 +188,11 @@
 
 #include <array>
 #include <deque>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <QCryptographicHash>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -197,6 +203,7 @@
 #include <App/MappedElement.h>
 #include <App/Application.h>
 #include <App/Document.h>
+#include <App/RecomputeProfiler.h>
 #include "PartFeature.h"
 
 #include "PartPyCXX.h"
@@ -344,10 +351,70 @@ struct ShapeSources {
     bool expanded = false;
 };
 
+/** Shape history recorded by makESHAPE() in lazy mode
+ *
+ * The history is copied from the original mapper, because the shape maker it
+ * refers to is usually gone by the time the element map is generated. So only
+ * the naming is delayed, not the history queries.
+ */
+struct PendingElementMap: TopoShape::Mapper {
+    typedef std::unordered_map<TopoDS_Shape, std::vector<TopoDS_Shape>, ShapeHasher, ShapeHasher> ShapeMap;
+    ShapeMap _generated;
+    ShapeMap _modified;
+    std::vector<TopoShape> sources;
+    std::string op;
+    bool hasOp = false;
+    long tag = 0;
+    App::StringHasherRef hasher;
+    /// Length of the chain of pending maps retained through the sources
+    int depth = 1;
+
+    /// Maximum chain length, see TopoShape::delayElementMap()
+    static const int MaxDepth = 4;
+
+    /// Memory of the recorded history, not counting the source shapes
+    std::size_t getMemSize() const {
+        std::size_t size = sizeof(*this) + op.capacity() + sources.capacity() * sizeof(TopoShape);
+        for (auto map : {&_generated, &_modified}) {
+            for (auto &v : *map)
+                size += sizeof(v) + v.second.capacity() * sizeof(TopoDS_Shape);
+        }
+        return size;
+    }
+
+    /// Release the history and the source shapes once the map is generated
+    void release() {
+        ShapeMap().swap(_generated);
+        ShapeMap().swap(_modified);
+        std::vector<TopoShape>().swap(sources);
+        hasher = App::StringHasherRef();
+    }
+
+    static void record(ShapeMap &map, const TopoDS_Shape &s, const std::vector<TopoDS_Shape> &shapes) {
+        if (!shapes.empty())
+            map[s] = shapes;
+    }
+
+    virtual const std::vector<TopoDS_Shape> &generated(const TopoDS_Shape &s) const override {
+        auto iter = _generated.find(s);
+        if(iter != _generated.end())
+            return iter->second;
+        return _res;
+    }
+
+    virtual const std::vector<TopoDS_Shape> &modified(const TopoDS_Shape &s) const override {
+        auto iter = _modified.find(s);
+        if(iter != _modified.end())
+            return iter->second;
+        return _res;
+    }
+};
+
 class TopoShape::Cache: public std::enable_shared_from_this<TopoShape::Cache>
 {
 public:
     ElementMapPtr cachedElementMap;
+    std::shared_ptr<PendingElementMap> pendingElementMap;
     TopLoc_Location subLocation;
     
     TopoDS_Shape shape;
@@ -355,6 +422,7 @@ public:
     TopLoc_Location locInv;
 
     std::size_t memsize = 0;
+    std::string geometryHash;
 
     struct AncestorInfo {
         bool inited = false;
@@ -594,6 +662,25 @@ void TopoShape::flushElementMap() const
         if (this->_Cache->cachedElementMap) {
             const_cast<TopoShape*>(this)->resetElementMap(this->_Cache->cachedElementMap);
         }
+        else if (this->_Cache->pendingElementMap) {
+            App::RecomputeProfiler::Scope scope("elementmap", "flushElementMap");
+            auto pending = std::move(this->_Cache->pendingElementMap);
+            auto self = const_cast<TopoShape*>(this);
+            // Generate using the tag and hasher at the time of makESHAPE()
+            long tag = self->Tag;
+            auto hasher = self->Hasher;
+            self->Tag = pending->tag;
+            self->Hasher = pending->hasher;
+            self->generateElementMap(*pending, pending->sources,
+                                     pending->hasOp ? pending->op.c_str() : nullptr);
+            self->Tag = tag;
+            self->Hasher = hasher;
+            // The pending map may still be referenced, e.g. by the boolean cache
+            pending->release();
+            // Share the result with other copies of this shape
+            if (auto map = elementMap(false))
+                this->_Cache->cachedElementMap = map;
+        }
         else if (this->_ParentCache) {
             TopoShape parent(this->Tag, this->Hasher, this->_ParentCache->shape);
             parent._Cache = _ParentCache;
@@ -635,11 +722,27 @@ void TopoShape::setShape(const TopoDS_Shape & shape, bool resetElementMap)
         INIT_SHAPE_CACHE();
 }
 
+std::shared_ptr<const void> TopoShape::getElementMapIdentity() const
+{
+    if (auto map = elementMap(false))
+        return map;
+    if (this->_Cache && !this->_ParentCache) {
+        if (this->_Cache->cachedElementMap)
+            return this->_Cache->cachedElementMap;
+        if (this->_Cache->pendingElementMap)
+            return this->_Cache->pendingElementMap;
+    }
+    // Sub-shape mapping is cheap to resolve
+    return elementMap();
+}
+
 bool TopoShape::hasPendingElementMap() const
 {
     return !elementMap(false)
         && this->_Cache
-        && (this->_ParentCache || this->_Cache->cachedElementMap);
+        && (this->_ParentCache
+                || this->_Cache->cachedElementMap
+                || this->_Cache->pendingElementMap);
 }
 
 void TopoShape::operator = (const TopoShape& sh)
@@ -3399,6 +3502,349 @@ TopoShape &TopoShape::makEShellFromWires(const std::vector<TopoShape> &wires, bo
     return *this;
 }
 
+namespace {
+
+/** Memoize the result of boolean operations
+ *
+ * The result, including its element map, is keyed by a digest of the
+ * geometry and element map identity of the input shapes and the operation
+ * parameters, so that recomputing a feature with unchanged input does not run
+ * OCCT again. The cache is bounded by parameter BooleanCacheSize (in MB), and
+ * evicts the least recently used result. It is disabled by default, and
+ * cleared when any document is closed to release its shapes and string hashers.
+ */
+class BooleanCache
+{
+public:
+    /// Cache key, holding the input element maps so that their identity stays unique
+    struct Key {
+        std::string digest;
+        std::vector<std::shared_ptr<const void> > maps;
+    };
+
+    static BooleanCache &instance()
+    {
+        // Intentionally leaked to avoid releasing OCCT shapes on exit
+        static BooleanCache *inst = new BooleanCache;
+        return *inst;
+    }
+
+    BooleanCache()
+    {
+        App::GetApplication().signalDeleteDocument.connect(
+            [this](const App::Document &) {
+                clear();
+            });
+    }
+
+    Key makeKey(const char *maker, const char *op, double tol,
+                const TopoShape &self, const std::vector<TopoShape> &inputs)
+    {
+        Key key;
+        if (PartParams::getBooleanCacheSize() <= 0) {
+            clear();
+            return key;
+        }
+
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+        auto addData = [&hasher](const void *data, std::size_t size) {
+            hasher.addData(static_cast<const char*>(data), static_cast<int>(size));
+        };
+        auto addHeader = [&addData](const TopoShape &shape) {
+            long tag = shape.Tag;
+            const App::StringHasher *ptr = shape.Hasher;
+            addData(&tag, sizeof(tag));
+            addData(&ptr, sizeof(ptr));
+        };
+
+        addData(maker, std::strlen(maker)+1);
+        addData(op, std::strlen(op)+1);
+        addData(&tol, sizeof(tol));
+        long clusterThreshold = PartParams::getBooleanClusterThreshold();
+        addData(&clusterThreshold, sizeof(clusterThreshold));
+        addHeader(self);
+
+        for (const auto &shape : inputs) {
+            if (shape.isNull()) {
+                key.maps.clear();
+                return key;
+            }
+            std::string buf = shape.getGeometryHash();
+            addData(buf.c_str(), buf.size());
+            addHeader(shape);
+            // Identify the element map without generating or flattening it
+            auto map = shape.getElementMapIdentity();
+            const void *ptr = map.get();
+            std::size_t count = shape.getElementMapSize(false);
+            addData(&ptr, sizeof(ptr));
+            addData(&count, sizeof(count));
+            key.maps.push_back(std::move(map));
+        }
+        QByteArray hash = hasher.result();
+        key.digest.assign(hash.constData(), hash.size());
+        return key;
+    }
+
+    bool get(const Key &key, TopoShape &res)
+    {
+        if (key.digest.empty())
+            return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entryMap.find(key.digest);
+        if (it == entryMap.end())
+            return false;
+        entries.splice(entries.begin(), entries, it->second);
+        res = it->second->shape;
+        return true;
+    }
+
+    void set(const Key &key, const TopoShape &shape)
+    {
+        if (key.digest.empty() || shape.isNull())
+            return;
+        std::size_t budget = static_cast<std::size_t>(PartParams::getBooleanCacheSize()) * 1024 * 1024;
+        std::size_t size = shape.getMemSize();
+        if (size > budget)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entryMap.find(key.digest);
+        if (it != entryMap.end()) {
+            memsize -= it->second->memsize;
+            entries.erase(it->second);
+            entryMap.erase(it);
+        }
+        entries.push_front(Entry{key, shape, size});
+        entryMap[key.digest] = entries.begin();
+        memsize += size;
+        while (memsize > budget) {
+            auto &entry = entries.back();
+            memsize -= entry.memsize;
+            entryMap.erase(entry.key.digest);
+            entries.pop_back();
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entryMap.clear();
+        entries.clear();
+        memsize = 0;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        TopoShape shape;
+        std::size_t memsize;
+    };
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entryMap;
+    std::size_t memsize = 0;
+    std::mutex mutex;
+};
+
+/// Shape mapper for boolean operations run separately on clusters of input shapes
+struct MapperClusters: TopoShape::Mapper {
+    std::vector<std::unique_ptr<BRepAlgoAPI_BooleanOperation> > makers;
+    std::vector<MapperMaker> mappers;
+    std::unordered_map<TopoDS_Shape, int, ShapeHasher, ShapeHasher> owners;
+
+    void addShape(const TopoDS_Shape &shape, int index) {
+        TopTools_IndexedMapOfShape subshapes;
+        TopExp::MapShapes(shape, subshapes);
+        for (int i=1; i<=subshapes.Extent(); ++i)
+            owners.emplace(subshapes.FindKey(i), index);
+    }
+
+    virtual const std::vector<TopoDS_Shape> &modified(const TopoDS_Shape &s) const override {
+        auto it = owners.find(s);
+        if (it == owners.end())
+            return _res;
+        return mappers[it->second].modified(s);
+    }
+
+    virtual const std::vector<TopoDS_Shape> &generated(const TopoDS_Shape &s) const override {
+        auto it = owners.find(s);
+        if (it == owners.end())
+            return _res;
+        return mappers[it->second].generated(s);
+    }
+};
+
+/** Run a fuse, cut or common operation separately on spatially independent clusters
+ *
+ * The input shapes are clustered by their overlapping bounding boxes. For
+ * cut and common, tools that do not overlap any argument are dropped, and so
+ * are arguments without tools for common. Each cluster is then run as a
+ * separate boolean operation in parallel, and the results are combined into
+ * one compound, with a single element mapping pass over all the inputs.
+ *
+ * @return Returns false if there is nothing to gain from clustering, in
+ *         which case the caller shall run the boolean operation as usual.
+ */
+static bool makEBooleanClusters(TopoShape &self,
+                                const char *maker,
+                                const std::vector<TopoShape> &inputs,
+                                const char *op)
+{
+    long threshold = PartParams::getBooleanClusterThreshold();
+    if (threshold <= 0 || static_cast<long>(inputs.size()) < threshold)
+        return false;
+
+    bool fuse = strcmp(maker, Part::OpCodes::Fuse)==0;
+    bool common = strcmp(maker, Part::OpCodes::Common)==0;
+    if (!fuse && !common && strcmp(maker, Part::OpCodes::Cut)!=0)
+        return false;
+
+    struct Item {
+        TopoDS_Shape shape;
+        bool tool;
+        Bnd_Box box;
+    };
+    std::vector<Item> items;
+    std::vector<TopoShape> arguments;
+    if (fuse)
+        arguments = inputs;
+    else
+        expandCompound(inputs[0], arguments);
+    for (auto &s : arguments)
+        items.push_back({s.getShape(), false, Bnd_Box()});
+    if (!fuse) {
+        for (std::size_t i=1; i<inputs.size(); ++i)
+            items.push_back({inputs[i].getShape(), true, Bnd_Box()});
+    }
+
+    std::vector<int> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (auto &item : items) {
+        BRepBndLib::Add(item.shape, item.box, Standard_False);
+        item.box.SetGap(Precision::Confusion());
+    }
+    auto xmin = [&](int i) {
+        double x1, y1, z1, x2, y2, z2;
+        items[i].box.Get(x1, y1, z1, x2, y2, z2);
+        return x1;
+    };
+    auto xmax = [&](int i) {
+        double x1, y1, z1, x2, y2, z2;
+        items[i].box.Get(x1, y1, z1, x2, y2, z2);
+        return x2;
+    };
+    std::sort(order.begin(), order.end(), [&](int a, int b) {return xmin(a) < xmin(b);});
+
+    // Sweep along X to find overlapping pairs, and merge them with union-find
+    std::vector<int> parents(items.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    std::function<int(int)> findRoot = [&](int i) {
+        return parents[i] == i ? i : (parents[i] = findRoot(parents[i]));
+    };
+    std::vector<int> active;
+    for (int i : order) {
+        double x = xmin(i);
+        active.erase(std::remove_if(active.begin(), active.end(),
+                    [&](int j) {return xmax(j) < x;}), active.end());
+        for (int j : active) {
+            // For cut and common, overlapping tools need not be merged
+            // unless they overlap the same argument
+            if (items[i].tool && items[j].tool)
+                continue;
+            if (!items[i].box.IsOut(items[j].box))
+                parents[findRoot(i)] = findRoot(j);
+        }
+        active.push_back(i);
+    }
+
+    struct Cluster {
+        TopTools_ListOfShape arguments;
+        TopTools_ListOfShape tools;
+    };
+    std::vector<Cluster> clusters;
+    std::map<int, int> clusterMap;
+    for (int i=0; i<static_cast<int>(items.size()); ++i) {
+        auto res = clusterMap.emplace(findRoot(i), static_cast<int>(clusters.size()));
+        if (res.second)
+            clusters.emplace_back();
+        auto &cluster = clusters[res.first->second];
+        if (items[i].tool)
+            cluster.tools.Append(items[i].shape);
+        else if (fuse && cluster.arguments.Size())
+            cluster.tools.Append(items[i].shape);
+        else
+            cluster.arguments.Append(items[i].shape);
+    }
+    if (clusters.size() == 1 && clusters[0].arguments.Size() && (fuse || clusters[0].tools.Size()))
+        return false;
+
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+
+    MapperClusters mapper;
+    std::vector<const Cluster*> jobs;
+    for (auto &cluster : clusters) {
+        if (cluster.tools.IsEmpty()) {
+            // Arguments without tools are kept as they are for fuse and cut
+            if (!common) {
+                for (TopTools_ListIteratorOfListOfShape it(cluster.arguments); it.More(); it.Next())
+                    builder.Add(comp, it.Value());
+            }
+            continue;
+        }
+        // Tools without arguments are dropped
+        if (cluster.arguments.IsEmpty())
+            continue;
+        jobs.push_back(&cluster);
+        if (fuse)
+            mapper.makers.emplace_back(new BRepAlgoAPI_Fuse);
+        else if (common)
+            mapper.makers.emplace_back(new BRepAlgoAPI_Common);
+        else
+            mapper.makers.emplace_back(new BRepAlgoAPI_Cut);
+        int index = static_cast<int>(mapper.makers.size()) - 1;
+        for (TopTools_ListIteratorOfListOfShape it(cluster.arguments); it.More(); it.Next())
+            mapper.addShape(it.Value(), index);
+        for (TopTools_ListIteratorOfListOfShape it(cluster.tools); it.More(); it.Next())
+            mapper.addShape(it.Value(), index);
+    }
+
+    std::vector<std::string> errors(jobs.size());
+    auto runJob = [&](int i) {
+        auto &mk = *mapper.makers[i];
+        try {
+            mk.SetArguments(jobs[i]->arguments);
+            mk.SetTools(jobs[i]->tools);
+            mk.SetNonDestructive(Standard_True);
+            mk.Build();
+            if (!mk.IsDone())
+                errors[i] = "boolean operation failed";
+        } catch (Standard_Failure &e) {
+            errors[i] = e.GetMessageString() ? e.GetMessageString() : "unknown OCCT error";
+        }
+    };
+#if OCC_VERSION_HEX >= 0x070500
+    OSD_Parallel::For(0, static_cast<int>(jobs.size()), runJob, jobs.size() < 2);
+#else
+    for (int i=0; i<static_cast<int>(jobs.size()); ++i)
+        runJob(i);
+#endif
+
+    for (std::size_t i=0; i<jobs.size(); ++i) {
+        if (errors[i].size())
+            FC_THROWM(Base::CADKernelError, "Boolean operation failed: " << errors[i]);
+        auto &mk = *mapper.makers[i];
+        mapper.mappers.emplace_back(mk);
+        for (TopoDS_Iterator it(mk.Shape()); it.More(); it.Next())
+            builder.Add(comp, it.Value());
+    }
+
+    self.makESHAPE(comp, mapper, inputs, op);
+    return true;
+}
+
+} // anonymous namespace
+
 TopoShape &TopoShape::makEBoolean(const char *maker,
         const std::vector<TopoShape> &shapes, const char *op, double tol)
 {
@@ -3415,6 +3861,8 @@ TopoShape &TopoShape::makEBoolean(const char *maker,
     if(shapes.empty())
         HANDLE_NULL_SHAPE;
 
+    App::RecomputeProfiler::Scope scope("occt", maker);
+
     if(strcmp(maker,Part::OpCodes::Compound)==0) {
         return makECompound(shapes,op,false);
     } else if(boost::starts_with(maker,Part::OpCodes::Face)) {
@@ -3516,6 +3964,10 @@ TopoShape &TopoShape::makEBoolean(const char *maker,
         return *this;
     }
 
+    auto cacheKey = BooleanCache::instance().makeKey(maker, op, tol, *this, inputs);
+    if (BooleanCache::instance().get(cacheKey, *this))
+        return *this;
+
 #if OCC_VERSION_HEX <= 0x060800
     TopoShape resShape = inputs[0];
     if (resShape.isNull())
@@ -3566,9 +4018,17 @@ TopoShape &TopoShape::makEBoolean(const char *maker,
 
     if(buildShell)
         makEShell();
+    BooleanCache::instance().set(cacheKey, *this);
     return *this;
 #else
 
+    if (tol <= 0.0 && makEBooleanClusters(*this, maker, inputs, op)) {
+        if(buildShell)
+            makEShell();
+        BooleanCache::instance().set(cacheKey, *this);
+        return *this;
+    }
+
     std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
     if(strcmp(maker, Part::OpCodes::Fuse)==0)
         mk.reset(new BRepAlgoAPI_Fuse);
@@ -3632,6 +4092,7 @@ TopoShape &TopoShape::makEBoolean(const char *maker,
 
     if(buildShell)
         makEShell();
+    BooleanCache::instance().set(cacheKey, *this);
     return *this;
 #endif
 }
@@ -3858,6 +4319,8 @@ TopoShape &TopoShape::makESHAPE(const TopoDS_Shape &shape, const Mapper &mapper,
     if(shapes.empty() || this->Tag == -1)
         return *this;
 
+    App::RecomputeProfiler::Scope scope("elementmap", op ? op : "makESHAPE");
+
     size_t canMap=0;
     for(auto &shape : shapes) {
         if(canMapElement(shape))
@@ -3868,6 +4331,63 @@ TopoShape &TopoShape::makESHAPE(const TopoDS_Shape &shape, const Mapper &mapper,
     if(canMap!=shapes.size() && FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
         FC_WARN("Not all input shapes are mappable");
 
+    if(!PartParams::getLazyElementMap() || !delayElementMap(mapper, shapes, op))
+        generateElementMap(mapper, shapes, op);
+    return *this;
+}
+
+bool TopoShape::delayElementMap(const Mapper &mapper,
+                                const std::vector<TopoShape> &shapes,
+                                const char *op)
+{
+    INIT_SHAPE_CACHE();
+    // Do not interfere with an element map shared through the cache
+    if (_Cache->cachedElementMap || _ParentCache)
+        return false;
+
+    // A pending map keeps its source shapes alive, including their own pending
+    // maps and thus their sources. Generate the element maps of the sources
+    // once the chain gets too long, which releases the shapes they retain.
+    int depth = 0;
+    for (auto &other : shapes) {
+        if (other._Cache && other._Cache->pendingElementMap)
+            depth = std::max(depth, other._Cache->pendingElementMap->depth);
+    }
+    if (depth >= PendingElementMap::MaxDepth) {
+        for (auto &other : shapes)
+            other.flushElementMap();
+        depth = 0;
+    }
+
+    auto pending = std::make_shared<PendingElementMap>();
+    pending->depth = depth + 1;
+    for (auto &other : shapes) {
+        if (!canMapElement(other))
+            continue;
+        for (auto type : {TopAbs_VERTEX, TopAbs_EDGE, TopAbs_FACE}) {
+            auto &otherMap = other._Cache->getInfo(type);
+            for (int i=1; i<=otherMap.count(); ++i) {
+                const auto &otherElement = otherMap.find(other._Shape, i);
+                PendingElementMap::record(pending->_modified, otherElement, mapper.modified(otherElement));
+                PendingElementMap::record(pending->_generated, otherElement, mapper.generated(otherElement));
+            }
+        }
+    }
+    pending->sources = shapes;
+    if (op) {
+        pending->op = op;
+        pending->hasOp = true;
+    }
+    pending->tag = Tag;
+    pending->hasher = Hasher;
+    _Cache->pendingElementMap = pending;
+    return true;
+}
+
+void TopoShape::generateElementMap(const Mapper &mapper,
+                                   const std::vector<TopoShape> &shapes,
+                                   const char *op)
+{
     if(!op) op = Part::OpCodes::Maker;
     std::string _op = op;
     _op += '_';
@@ -4371,7 +4891,6 @@ TopoShape &TopoShape::makESHAPE(const TopoDS_Shape &shape, const Mapper &mapper,
             break;
         delayed = true;
     }
-    return *this;
 }
 
 const std::string &TopoShape::modPostfix() {
@@ -5637,7 +6156,7 @@ TopoShape_RefCountShapes(std::unordered_set<TopoDS_Shape> &shapeSet,
     TopoDS_Iterator it;
     // go through all direct children
     for (it.Initialize(aShape, false, false);it.More(); it.Next()) {
-        size += TopoShape_RefCountShapes(shapeSet, aShape);
+        size += TopoShape_RefCountShapes(shapeSet, it.Value());
     }
 
     return size;
@@ -5652,10 +6171,6 @@ std::size_t TopoShape::Cache::getMemSize()
     this->memsize = TopoShape_RefCountShapes(shapeSet, this->shape);
 
     for (const auto & shape : shapeSet) {
-        // Only check geometrical element for non compound shapes
-        if (TopoDS_Iterator(shape, false, false).More())
-            continue;
-
         // add the size of the underlying geomtric data
         Handle(TopoDS_TShape) tshape = shape.TShape();
         this->memsize += tshape->DynamicType()->Size();
@@ -5780,10 +6295,106 @@ std::size_t TopoShape::Cache::getMemSize()
     return this->memsize;
 }
 
+// Triangulation is not cached, because meshing modifies the shape in place
+static std::size_t TopoShape_TriangulationMemSize(const TopoDS_Shape &shape)
+{
+    std::size_t size = 0;
+    if (shape.IsNull())
+        return size;
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(shape, TopAbs_FACE, faces);
+    for (int i = 1; i <= faces.Extent(); ++i) {
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faces(i)), loc);
+        if (mesh.IsNull())
+            continue;
+        size += sizeof(Poly_Triangulation);
+        size += mesh->NbNodes() * sizeof(gp_Pnt);
+        size += mesh->NbTriangles() * sizeof(Poly_Triangle);
+        if (mesh->HasUVNodes())
+            size += mesh->NbNodes() * sizeof(gp_Pnt2d);
+        if (mesh->HasNormals())
+            size += mesh->NbNodes() * 3 * sizeof(float);
+    }
+
+    TopTools_IndexedMapOfShape edges;
+    TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+    for (int i = 1; i <= edges.Extent(); ++i) {
+        TopLoc_Location loc;
+        Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(TopoDS::Edge(edges(i)), loc);
+        if (!polygon.IsNull())
+            size += sizeof(Poly_Polygon3D) + polygon->NbNodes() * sizeof(gp_Pnt);
+    }
+    return size;
+}
+
 unsigned int TopoShape::getMemSize (void) const
 {
     INIT_SHAPE_CACHE();
-    return _Cache->getMemSize() + Data::ComplexGeoData::getMemSize();
+    std::size_t pending = 0;
+    if (_Cache->pendingElementMap && hasPendingElementMap())
+        pending = _Cache->pendingElementMap->getMemSize();
+    return static_cast<unsigned int>(_Cache->getMemSize()
+            + TopoShape_TriangulationMemSize(_Shape)
+            + Data::ComplexGeoData::getMemSize()
+            + pending);
+}
+
+std::string TopoShape::getGeometryHash() const
+{
+    if (_Shape.IsNull())
+        return std::string();
+
+    INIT_SHAPE_CACHE();
+    // The shape cache may be shared by shapes used in different threads
+    static std::mutex mutex;
+    std::string geometryHash;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        geometryHash = _Cache->geometryHash;
+    }
+    if (geometryHash.empty()) {
+        std::ostringstream ss;
+        ss.imbue(std::locale::classic());
+        TopoShape(_Cache->shape).exportBrep(ss);
+        std::string data = ss.str();
+        QByteArray hash = QCryptographicHash::hash(
+                QByteArray::fromRawData(data.c_str(), static_cast<int>(data.size())),
+                QCryptographicHash::Sha1);
+        geometryHash.assign(hash.constData(), hash.size());
+        std::lock_guard<std::mutex> lock(mutex);
+        _Cache->geometryHash = geometryHash;
+    }
+
+    // The cache is shared by shapes of different placement
+    if (_Shape.Location().IsIdentity())
+        return geometryHash;
+    QCryptographicHash hasher(QCryptographicHash::Sha1);
+    hasher.addData(geometryHash.c_str(), static_cast<int>(geometryHash.size()));
+    gp_Trsf trsf = _Shape.Location().Transformation();
+    for (int row=1; row<=3; ++row) {
+        for (int col=1; col<=4; ++col) {
+            double value = trsf.Value(row, col);
+            hasher.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+    QByteArray hash = hasher.result();
+    return std::string(hash.constData(), hash.size());
+}
+
+void TopoShape::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    INIT_SHAPE_CACHE();
+    if (auto size = _Cache->getMemSize())
+        sizes["BRep"] += size;
+    if (auto size = TopoShape_TriangulationMemSize(_Shape))
+        sizes["Triangulation"] += size;
+    // Do not generate pending element maps only to measure them
+    if (auto size = getElementMapMemSize(false))
+        sizes["ElementMap"] += size;
+    else if (_Cache->pendingElementMap && hasPendingElementMap())
+        sizes["PendingElementMap"] += _Cache->pendingElementMap->getMemSize();
 }
 
 TopoShape TopoShape::splitWires(std::vector<TopoShape> *inner,
@@ -63,6 +63,9 @@ Params = [
     ParamInt("SelectionPickThreshold", 1000),
     ParamInt("SelectionPickThreshold2", 500),
     ParamBool("SelectionPickRTree", False),
+    ParamInt("AsyncTessellationThreshold", 1000, doc=\
+        "Tessellate shapes with at least this number of faces in a background thread, while keeping\n"
+        "the previous representation on screen. Zero disables background tessellation."),
 ]
 
 def declare():
@@ -93,6 +93,7 @@ public:
     long SelectionPickThreshold;
     long SelectionPickThreshold2;
     bool SelectionPickRTree;
+    long AsyncTessellationThreshold;
 
     // Auto generated code (Tools/params_utils.py:203)
     PartParamsP() {
@@ -151,6 +152,8 @@ public:
         funcs["SelectionPickThreshold2"] = &PartParamsP::updateSelectionPickThreshold2;
         SelectionPickRTree = handle->GetBool("SelectionPickRTree", false);
         funcs["SelectionPickRTree"] = &PartParamsP::updateSelectionPickRTree;
+        AsyncTessellationThreshold = handle->GetInt("AsyncTessellationThreshold", 1000);
+        funcs["AsyncTessellationThreshold"] = &PartParamsP::updateAsyncTessellationThreshold;
     }
 
     // Auto generated code (Tools/params_utils.py:217)
@@ -297,6 +300,10 @@ public:
     static void updateSelectionPickRTree(PartParamsP *self) {
         self->SelectionPickRTree = self->handle->GetBool("SelectionPickRTree", false);
     }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateAsyncTessellationThreshold(PartParamsP *self) {
+        self->AsyncTessellationThreshold = self->handle->GetInt("AsyncTessellationThreshold", 1000);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:256)
@@ -1013,6 +1020,35 @@ void PartParams::setSelectionPickRTree(const bool &v) {
 void PartParams::removeSelectionPickRTree() {
     instance()->handle->RemoveBool("SelectionPickRTree");
 }
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docAsyncTessellationThreshold() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Tessellate shapes with at least this number of faces in a background thread, while keeping\n"
+"the previous representation on screen. Zero disables background tessellation.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & PartParams::getAsyncTessellationThreshold() {
+    return instance()->AsyncTessellationThreshold;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & PartParams::defaultAsyncTessellationThreshold() {
+    const static long def = 1000;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setAsyncTessellationThreshold(const long &v) {
+    instance()->handle->SetInt("AsyncTessellationThreshold",v);
+    instance()->AsyncTessellationThreshold = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeAsyncTessellationThreshold() {
+    instance()->handle->RemoveInt("AsyncTessellationThreshold");
+}
 //[[[end]]]
 
 void PartParams::onMeshDeviationChanged() {
@@ -336,6 +336,19 @@ public:
     static const char *docSelectionPickRTree();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter AsyncTessellationThreshold
+    ///
+    /// Tessellate shapes with at least this number of faces in a background thread, while keeping
+    /// the previous representation on screen. Zero disables background tessellation.
+    static const long & getAsyncTessellationThreshold();
+    static const long & defaultAsyncTessellationThreshold();
+    static void removeAsyncTessellationThreshold();
+    static void setAsyncTessellationThreshold(const long &v);
+    static const char *docAsyncTessellationThreshold();
+    //@}
+
 // Auto generated code (Tools/params_utils.py:150)
 }; // class PartParams
 } // namespace PartGui
@@ -72,6 +72,8 @@
 # include <QMenu>
 #endif
 
+#include <QThread>
+
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -95,6 +97,7 @@
 #include <Gui/InventorBase.h>
 #include <Gui/BitmapFactory.h>
 #include <Gui/Control.h>
+#include <Gui/SoFCBoundingBox.h>
 #include <Gui/SoFCSelectionAction.h>
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/ViewParams.h>
@@ -106,6 +109,7 @@
 #include "SoBrepFaceSet.h"
 #include "SoBrepPointSet.h"
 #include "TaskFaceColors.h"
+#include "VisualTessellation.h"
 
 
 #include "ViewProviderPartExtPy.h"
@@ -292,6 +296,8 @@ ViewProviderPartExt::~ViewProviderPartExt()
     pcLineStyle->unref();
     pcPointStyle->unref();
     pShapeHints->unref();
+    if (visualJob)
+        visualJob->canceled = true;
     static_cast<SoFCCoordinate3*>(coords)->vp = nullptr;
     coords->unref();
     pcoords->unref();
@@ -1807,6 +1813,18 @@ static void registerShape(Part::TopoShape &shape, const Part::TopoShape &newshap
 }
 }
 
+namespace {
+
+template<class FieldT, class T>
+void setFieldValues(FieldT &field, const std::vector<T> &values)
+{
+    field.setNum((int)values.size());
+    if (!values.empty())
+        field.setValues(0, (int)values.size(), &values[0]);
+}
+
+} // anonymous namespace
+
 void ViewProviderPartExt::updateVisual()
 {
     if (!getObject()
@@ -1817,6 +1835,158 @@ void ViewProviderPartExt::updateVisual()
         return;
     }
 
+    Part::TopoShape toposhape = getShape();
+    // We must reset the location here because the transformation data
+    // are set in the placement property
+    TopLoc_Location aLoc;
+    toposhape.setShape(toposhape.getShape().Located(aLoc), false);
+
+    VisualData data;
+    data.shape = toposhape.getShape();
+    data.deviation = std::max(PartParams::getOverrideTessellation() ?
+                                PartParams::getMeshDeviation() : Deviation.getValue(),
+                              PartParams::getMinimumDeviation());
+    data.angularDeflection = std::max(Precision::Angular(),
+        std::max((PartParams::getOverrideTessellation() ?
+                    PartParams::getMeshAngularDeflection() : AngularDeflection.getValue()),
+                  PartParams::getMinimumAngularDeflection()) / 180.0 * M_PI);
+    data.normalsFromUV = NormalsFromUV;
+
+    if (visualJob) {
+        // Keep the pending job if it is already working on the same shape
+        if (!data.shape.IsNull()
+                && visualJob->shape.getShape().IsPartner(data.shape)
+                && visualJob->data.sameParameters(data))
+        {
+            VisualTouched = false;
+            return;
+        }
+        cancelVisualJob();
+    }
+
+    if (!data.shape.IsNull() && startVisualJob(toposhape, data))
+        return;
+
+    // copy edge sub shape to work around OCC trangulation bug (in
+    // case the edge is part of a face of some other shape in a
+    // different location). Seems OCC 7.4 has fixed problem.
+#if OCC_VERSION_HEX < 0x070400
+    if (!toposhape.hasSubShape(TopAbs_FACE) && toposhape.hasSubShape(TopAbs_EDGE))
+        data.shape = BRepBuilderAPI_Copy(data.shape).Shape();
+#endif
+
+    if (!data.shape.IsNull()) {
+        std::string error;
+        try {
+            data.compute();
+        }
+        catch (Base::Exception &e) {
+            error = e.what();
+        }
+        catch (const Standard_Failure& e) {
+            error = e.GetMessageString();
+        }
+        catch (...) {
+            error = "unknown exception";
+        }
+        if (!error.empty()) {
+            FC_ERR("Failed to compute Inventor representation for the shape of "
+                    << pcObject->getFullName() << ": " << error);
+            data.clear();
+        }
+    }
+    applyVisual(toposhape, data);
+}
+
+bool ViewProviderPartExt::startVisualJob(const Part::TopoShape &toposhape, VisualData &data)
+{
+#if OCC_VERSION_HEX < 0x070500
+    (void)toposhape;
+    (void)data;
+    return false;
+#else
+    long threshold = PartParams::getAsyncTessellationThreshold();
+    if (threshold <= 0
+            || !qApp
+            || QThread::currentThread() != qApp->thread()
+            || toposhape.countSubShapes(TopAbs_FACE) < threshold)
+        return false;
+
+    // The job is canceled before this view provider is destroyed
+    auto job = VisualJob::start(toposhape, std::move(data), [this](VisualJob &finished) {
+        if (visualJob.get() == &finished)
+            finishVisualJob();
+    });
+    visualJob = job;
+    VisualTouched = false;
+
+    // Keep showing the previous representation meanwhile. If there is none,
+    // e.g. for a freshly imported shape, show its bounding box instead.
+    if (!coords->point.getNum() && !BoundingBox.getValue()) {
+        Base::BoundBox3d box = toposhape.getBoundBox();
+        if (box.IsValid()) {
+            job->showBoundBox = true;
+            showBoundingBox(true);
+            if (pcBoundingBox) {
+                pcBoundingBox->minBounds.setValue(box.MinX, box.MinY, box.MinZ);
+                pcBoundingBox->maxBounds.setValue(box.MaxX, box.MaxY, box.MaxZ);
+            }
+        }
+    }
+    FC_LOG(getFullName() << " start tessellation in background");
+    return true;
+#endif
+}
+
+void ViewProviderPartExt::finishVisualJob()
+{
+    auto job = std::move(visualJob);
+    if (!job || job->canceled)
+        return;
+
+    if (job->showBoundBox && !BoundingBox.getValue())
+        showBoundingBox(false);
+
+    // The shape or the tessellation parameters may have been changed while
+    // hidden, which does not cancel the job. Drop the stale result.
+    if (VisualTouched || !getShape().getShape().IsPartner(job->shape.getShape())) {
+        VisualTouched = true;
+        if (isUpdateForced() || Visibility.getValue())
+            updateVisual();
+        return;
+    }
+
+    if (!job->error.empty()) {
+        FC_ERR("Failed to compute Inventor representation for the shape of "
+                << pcObject->getFullName() << ": " << job->error);
+        job->data.clear();
+    }
+#if OCC_VERSION_HEX >= 0x070500
+    else {
+        // Keep the mesh with the shape, as meshing it synchronously would
+        job->attachTessellation();
+    }
+#endif
+    applyVisual(job->shape, job->data);
+
+    if (this->faceset->partIndex.getNum() >
+        this->pcShapeMaterial->diffuseColor.getNum()) {
+        this->pcFaceBind->value = SoMaterialBinding::OVERALL;
+    }
+}
+
+void ViewProviderPartExt::cancelVisualJob()
+{
+    if (!visualJob)
+        return;
+    visualJob->canceled = true;
+    if (visualJob->showBoundBox && !BoundingBox.getValue())
+        showBoundingBox(false);
+    visualJob.reset();
+}
+
+void ViewProviderPartExt::applyVisual(const Part::TopoShape &toposhape, VisualData &data)
+{
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
@@ -1832,11 +2002,6 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
 
-    Part::TopoShape toposhape = getShape();
-    // We must reset the location here because the transformation data
-    // are set in the placement property
-    TopLoc_Location aLoc;
-    toposhape.setShape(toposhape.getShape().Located(aLoc), false);
     lineset ->seamIndices.setNum(0);
     registerShape(cachedShape, toposhape);
     if (cachedShape.isNull()) {
@@ -1878,375 +2043,20 @@ void ViewProviderPartExt::updateVisual()
     }
     faceset->shapeInfo.enableNotify(TRUE);
 
-    TopoDS_Shape cShape = cachedShape.getShape();
-
-    // copy edge sub shape to work around OCC trangulation bug (in
-    // case the edge is part of a face of some other shape in a
-    // different location). Seems OCC 7.4 has fixed problem.
-#if OCC_VERSION_HEX < 0x070400
-    if (!toposhape.hasSubShape(TopAbs_FACE) && toposhape.hasSubShape(TopAbs_EDGE))
-        cShape = BRepBuilderAPI_Copy(cShape).Shape();
-#endif
-
-    // time measurement and book keeping
-    Base::TimeInfo start_time;
-    int numTriangles=0,numNodes=0,numPoints=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
-    std::unordered_map<TopoDS_Shape, TopoDS_Face, Part::ShapeHasher, Part::ShapeHasher> faceEdges;
-
-    try {
-        // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = std::max(Precision::Confusion(),
-            ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
-                std::max(PartParams::getOverrideTessellation() ? PartParams::getMeshDeviation() : Deviation.getValue(),
-                     PartParams::getMinimumDeviation()));
-
-        // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
-        // should be displayed.
-        if (deflection < gp::Resolution())
-            deflection = Precision::Confusion();
-
-        // create or use the mesh on the data structure
-        Standard_Real AngDeflectionRads = std::max(Precision::Angular(),
-            std::max((PartParams::getOverrideTessellation() ?
-                        PartParams::getMeshAngularDeflection() : AngularDeflection.getValue()),
-                      PartParams::getMinimumAngularDeflection()) / 180.0 * M_PI);
-
-        BRepMesh_IncrementalMesh(cShape,deflection,Standard_False, AngDeflectionRads,Standard_True);
-
-        // count triangles and nodes in the mesh
-        TopTools_IndexedMapOfShape faceMap;
-        TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
-        for (int i=1; i <= faceMap.Extent(); i++) {
-            TopoDS_Face face = TopoDS::Face(faceMap(i));
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(face);
-            }
-            // Note: we must also count empty faces
-            if (!mesh.IsNull()) {
-                numTriangles += mesh->NbTriangles();
-                numNodes     += mesh->NbNodes();
-                numNorms     += mesh->NbNodes();
-            }
-
-            TopExp_Explorer xp;
-            for (xp.Init(face,TopAbs_EDGE);xp.More();xp.Next())
-                faceEdges.emplace(xp.Current(), face);
-            numFaces++;
-        }
-
-        // get an indexed map of edges
-        TopTools_IndexedMapOfShape edgeMap;
-        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
-
-         // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
-        std::map<int, std::vector<int32_t> > lineSetMap;
-        std::set<int>          edgeIdxSet;
-        std::vector<int32_t>   edgeVector;
-        std::vector<int32_t>   seamEdges;
-
-        // count and index the edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            edgeIdxSet.insert(i);
-            numEdges++;
-
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-            // returns a valid object is wrong. This e.g. happens for ruled
-            // surfaces which gets created by two edges or wires.
-            // So, we have to store the hashes of the edges associated to a face.
-            // If the hash of a given edge is not in this list we know it's really
-            // a free edge.
-            auto it = faceEdges.find(aEdge);
-            if (it != faceEdges.end()) {
-                if (BRep_Tool::IsClosed(aEdge, it->second))
-                    seamEdges.push_back(i-1);
-            } else {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    int nbNodesInEdge = aPoly->NbNodes();
-                    numNodes += nbNodesInEdge;
-                }
-            }
-        }
-
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
-
-        int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
-        for (int i=1; i <= faceMap.Extent(); i++, ii++) {
-            TopLoc_Location aLoc;
-            const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
-            // get the mesh of the shape
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(actFace);
-            }
-            if (mesh.IsNull()) {
-                parts[ii] = 0;
-                continue;
-            }
-
-            // getting the transformation of the shape/face
-            gp_Trsf myTransf;
-            Standard_Boolean identity = true;
-            if (!aLoc.IsIdentity()) {
-                identity = false;
-                myTransf = aLoc.Transformation();
-            }
-
-            // getting size of node and triangle array of this face
-            int nbNodesInFace = mesh->NbNodes();
-            int nbTriInFace   = mesh->NbTriangles();
-            // check orientation
-            TopAbs_Orientation orient = actFace.Orientation();
-
-
-            // cycling through the poly mesh
-#if OCC_VERSION_HEX < 0x070600
-            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-            TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-#else
-            int numNodes =  mesh->NbNodes();
-            TColgp_Array1OfDir Normals (1, numNodes);
-#endif
-            if (NormalsFromUV)
-                Part::Tools::getPointNormals(actFace, mesh, Normals);
-
-            for (int g=1;g<=nbTriInFace;g++) {
-                // Get the triangle
-                Standard_Integer N1,N2,N3;
-#if OCC_VERSION_HEX < 0x070600
-                Triangles(g).Get(N1,N2,N3);
-#else
-                mesh->Triangle(g).Get(N1,N2,N3);
-#endif
-
-                // change orientation of the triangle if the face is reversed
-                if ( orient != TopAbs_FORWARD ) {
-                    Standard_Integer tmp = N1;
-                    N1 = N2;
-                    N2 = tmp;
-                }
-
-                // get the 3 points of this triangle
-#if OCC_VERSION_HEX < 0x070600
-                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
-#else
-                gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
-#endif
-
-                // get the 3 normals of this triangle
-                gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
-                    NV1.SetXYZ(Normals(N1).XYZ());
-                    NV2.SetXYZ(Normals(N2).XYZ());
-                    NV3.SetXYZ(Normals(N3).XYZ());
-                }
-                else {
-                    gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
-                           v2(V2.X(),V2.Y(),V2.Z()),
-                           v3(V3.X(),V3.Y(),V3.Z());
-                    gp_Vec normal = (v2-v1)^(v3-v1);
-                    NV1 = normal;
-                    NV2 = normal;
-                    NV3 = normal;
-                }
-
-                // transform the vertices and normals to the place of the face
-                if (!identity) {
-                    V1.Transform(myTransf);
-                    V2.Transform(myTransf);
-                    V3.Transform(myTransf);
-                    if (NormalsFromUV) {
-                        NV1.Transform(myTransf);
-                        NV2.Transform(myTransf);
-                        NV3.Transform(myTransf);
-                    }
-                }
-
-                // add the normals for all points of this triangle
-                norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
-                norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
-                norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
-
-                // set the vertices
-                verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
-                verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
-                verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
-
-                // set the index vector with the 3 point indexes and the end delimiter
-                index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
-                index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
-                index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
-                index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
-            }
-
-            parts[ii] = nbTriInFace; // new part
-
-            // handling the edges lying on this face
-            TopExp_Explorer Exp;
-            for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
-                const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
-                // get the overall index of this edge
-                int edgeIndex = edgeMap.FindIndex(curEdge);
-                edgeVector.push_back((int32_t)edgeIndex-1);
-                // already processed this index ?
-                if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-
-                    // this holds the indices of the edge's triangulation to the current polygon
-                    Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                    if (aPoly.IsNull())
-                        continue; // polygon does not exist
-
-                    // getting the indexes of the edge polygon
-                    const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                    for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
-                        int nodeIndex = indices(i);
-                        int index = faceNodeOffset+nodeIndex-1;
-                        lineSetMap[edgeIndex].push_back(index);
-
-                        // usually the coordinates for this edge are already set by the
-                        // triangles of the face this edge belongs to. However, there are
-                        // rare cases where some points are only referenced by the polygon
-                        // but not by any triangle. Thus, we must apply the coordinates to
-                        // make sure that everything is properly set.
-#if OCC_VERSION_HEX < 0x070600
-                        gp_Pnt p(Nodes(nodeIndex));
-#else
-                        gp_Pnt p(mesh->Node(nodeIndex));
-#endif
-                        if (!identity)
-                            p.Transform(myTransf);
-                        verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
-                    }
-
-                    // remove the handled edge index from the set
-                    edgeIdxSet.erase(edgeIndex);
-                }
-            }
-
-            edgeVector.push_back(-1);
-
-            // counting up the per Face offsets
-            faceNodeOffset += nbNodesInFace;
-            faceTriaOffset += nbTriInFace;
-        }
-
-        // handling of the free edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            Standard_Boolean identity = true;
-            gp_Trsf myTransf;
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            if (!faceEdges.count(aEdge)) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    if (!aLoc.IsIdentity()) {
-                        identity = false;
-                        myTransf = aLoc.Transformation();
-                    }
-
-                    const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                    int nbNodesInEdge = aPoly->NbNodes();
-
-                    gp_Pnt pnt;
-                    for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
-                        pnt = aNodes(j);
-                        if (!identity)
-                            pnt.Transform(myTransf);
-                        int index = faceNodeOffset+j-1;
-                        verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-                        lineSetMap[i].push_back(index);
-                    }
-
-                    faceNodeOffset += nbNodesInEdge;
-                }
-            }
-        }
-
-        // handling of the vertices
-        TopTools_IndexedMapOfShape vertexMap;
-        TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
-
-        numPoints = vertexMap.Extent();
-        pcoords->point.setNum(numPoints);
-        verts = pcoords->point.startEditing();
-
-        for (int i=0; i<numPoints; i++) {
-            const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
-            gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
-            verts[i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-        }
-
-        // normalize all normals
-        for (int i = 0; i< numNorms ;i++)
-            norms[i].normalize();
-
-        std::vector<int32_t> lineSetCoords;
-        for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
-            lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
-            lineSetCoords.push_back(-1);
-        }
-
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
-
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
-
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        pcoords ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
-        if (seamEdges.size())
-            lineset->seamIndices.setValues(0, seamEdges.size(), &seamEdges[0]);
-    }
-    catch (Base::Exception &e) {
-        FC_ERR("Failed to compute Inventor representation for the shape of " << pcObject->getFullName() << ": " << e.what());
-    }
-    catch (const Standard_Failure& e) {
-        FC_ERR("Cannot compute Inventor representation for the shape of "
-               << pcObject->getFullName() << ": " << e.GetMessageString());
-    }
-    catch (...) {
-        FC_ERR("Failed to compute Inventor representation for the shape of " << pcObject->getFullName());
-    }
+    setFieldValues(coords->point, data.verts);
+    setFieldValues(pcoords->point, data.points);
+    setFieldValues(norm->vector, data.norms);
+    setFieldValues(faceset->coordIndex, data.index);
+    setFieldValues(faceset->partIndex, data.parts);
+    setFieldValues(lineset->coordIndex, data.lines);
+    if (data.seams.size())
+        lineset->seamIndices.setValues(0, data.seams.size(), &data.seams[0]);
 
     // printing some information
-    FC_TRACE(getFullName() << " update time: " << Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
-    FC_TRACE("Shape tria info: Faces:" << numFaces << " Edges:" << numEdges 
-             << " Points:" << numPoints << " Nodes:" << numNodes
-             << " Triangles:" << numTriangles << " IdxVec:" << numLines);
+    FC_TRACE(getFullName() << " update time: " << data.duration);
+    FC_TRACE("Shape tria info: Faces:" << data.numFaces << " Edges:" << data.numEdges
+             << " Points:" << data.numPoints << " Nodes:" << data.numNodes
+             << " Triangles:" << data.numTriangles << " IdxVec:" << data.numLines);
     VisualTouched = false;
 
     // The material has to be checked again (#0001736)
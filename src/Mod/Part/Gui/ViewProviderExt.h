@@ -24,6 +24,7 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include <map>
+#include <memory>
 #include <Standard_math.hxx>
 
 #include <App/PropertyUnits.h>
@@ -56,6 +57,8 @@ class SoIndexedLineSet;
 
 namespace PartGui {
 
+struct VisualData;
+struct VisualJob;
 class SoBrepFaceSet;
 class SoBrepEdgeSet;
 class SoBrepPointSet;
@@ -175,6 +178,12 @@ public:
     void setHighlightFaceEdges(bool enable);
 
     Part::TopoShape getShape() const;
+    /** Update the visual nodes from the shape
+     *
+     * Shapes with many faces are tessellated in a background thread (see
+     * PartParams::getAsyncTessellationThreshold()). The previous
+     * representation stays on screen until the new one is swapped in.
+     */
     virtual void updateVisual();
 
     virtual void reattach(App::DocumentObject *) override;
@@ -237,7 +246,13 @@ private:
     static const char* LightingEnums[];
     static const char* DrawStyleEnums[];
 
+    void applyVisual(const Part::TopoShape &shape, VisualData &data);
+    bool startVisualJob(const Part::TopoShape &shape, VisualData &data);
+    void finishVisualJob();
+    void cancelVisualJob();
+
     Part::TopoShape cachedShape;
+    std::shared_ptr<VisualJob> visualJob;
     boost::signals2::scoped_connection conn;
 };
 
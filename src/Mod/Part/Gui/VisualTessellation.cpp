@@ -0,0 +1,520 @@
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>       *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <map>
+# include <set>
+# include <unordered_map>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRep_Tool.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepMesh_IncrementalMesh.hxx>
+# include <gp_Trsf.hxx>
+# include <Precision.hxx>
+# include <Poly_Array1OfTriangle.hxx>
+# include <Poly_Polygon3D.hxx>
+# include <Poly_PolygonOnTriangulation.hxx>
+# include <Poly_Triangulation.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TColgp_Array1OfDir.hxx>
+# include <TColgp_Array1OfPnt.hxx>
+# include <TColStd_Array1OfInteger.hxx>
+# include <TopExp.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopoDS.hxx>
+# include <TopoDS_Edge.hxx>
+# include <TopoDS_Face.hxx>
+# include <TopoDS_Vertex.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <Inventor/nodes/SoIndexedFaceSet.h>
+#endif
+
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+#include <Standard_Version.hxx>
+#if OCC_VERSION_HEX >= 0x070500
+# include <Message_ProgressIndicator.hxx>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/TimeInfo.h>
+#include <Mod/Part/App/Tools.h>
+
+#include "VisualTessellation.h"
+
+using namespace PartGui;
+
+namespace {
+
+#if OCC_VERSION_HEX >= 0x070500
+// Progress indicator used to abort the meshing of a shape that has been
+// changed again while being tessellated in the background
+class VisualProgress : public Message_ProgressIndicator
+{
+public:
+    explicit VisualProgress(const std::atomic<bool> &canceled)
+        : canceled(canceled)
+    {}
+
+    Standard_Boolean UserBreak() override {
+        return canceled;
+    }
+
+    void Show(const Message_ProgressScope &, const Standard_Boolean) override {
+    }
+
+private:
+    const std::atomic<bool> &canceled;
+};
+#endif
+
+} // anonymous namespace
+
+bool VisualData::compute(const std::atomic<bool> *canceled)
+{
+    Base::TimeInfo start_time;
+    auto isCanceled = [canceled]() {
+        return canceled && *canceled;
+    };
+
+    const TopoDS_Shape &cShape = shape;
+    std::unordered_map<TopoDS_Shape, TopoDS_Face, Part::ShapeHasher, Part::ShapeHasher> faceEdges;
+
+    // calculating the deflection value
+    Bnd_Box bounds;
+    BRepBndLib::Add(cShape, bounds);
+    bounds.SetGap(0.0);
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    Standard_Real deflection = std::max(Precision::Confusion(),
+        ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * deviation);
+
+    // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
+    // should be displayed.
+    if (deflection < gp::Resolution())
+        deflection = Precision::Confusion();
+
+    // create or use the mesh on the data structure
+#if OCC_VERSION_HEX >= 0x070500
+    if (canceled) {
+        IMeshTools_Parameters meshParams;
+        meshParams.Deflection = deflection;
+        meshParams.Angle = angularDeflection;
+        meshParams.Relative = Standard_False;
+        meshParams.InParallel = Standard_True;
+        Handle(VisualProgress) progress = new VisualProgress(*canceled);
+        BRepMesh_IncrementalMesh(cShape, meshParams, progress->Start());
+    }
+    else
+#endif
+    BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,angularDeflection,Standard_True);
+
+    if (isCanceled())
+        return false;
+
+    // count triangles and nodes in the mesh
+    TopLoc_Location aLoc;
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
+    for (int i=1; i <= faceMap.Extent(); i++) {
+        TopoDS_Face face = TopoDS::Face(faceMap(i));
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(face);
+        }
+        // Note: we must also count empty faces
+        if (!mesh.IsNull()) {
+            numTriangles += mesh->NbTriangles();
+            numNodes     += mesh->NbNodes();
+            numNorms     += mesh->NbNodes();
+        }
+
+        TopExp_Explorer xp;
+        for (xp.Init(face,TopAbs_EDGE);xp.More();xp.Next())
+            faceEdges.emplace(xp.Current(), face);
+        numFaces++;
+    }
+
+    // get an indexed map of edges
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
+
+     // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
+    std::map<int, std::vector<int32_t> > lineSetMap;
+    std::set<int>          edgeIdxSet;
+
+    // count and index the edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        edgeIdxSet.insert(i);
+        numEdges++;
+
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+        // returns a valid object is wrong. This e.g. happens for ruled
+        // surfaces which gets created by two edges or wires.
+        // So, we have to store the hashes of the edges associated to a face.
+        // If the hash of a given edge is not in this list we know it's really
+        // a free edge.
+        auto it = faceEdges.find(aEdge);
+        if (it != faceEdges.end()) {
+            if (BRep_Tool::IsClosed(aEdge, it->second))
+                seams.push_back(i-1);
+        } else {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                int nbNodesInEdge = aPoly->NbNodes();
+                numNodes += nbNodesInEdge;
+            }
+        }
+    }
+
+    // create memory for the nodes and indexes, and preset the normal vector
+    // with null vector
+    this->verts.resize(numNodes);
+    this->norms.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+    this->index.resize(numTriangles*4);
+    this->parts.resize(numFaces);
+    SbVec3f* verts = numNodes ? &this->verts[0] : nullptr;
+    SbVec3f* norms = numNorms ? &this->norms[0] : nullptr;
+    int32_t* index = numTriangles ? &this->index[0] : nullptr;
+    int32_t* parts = numFaces ? &this->parts[0] : nullptr;
+
+    int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
+    for (int i=1; i <= faceMap.Extent(); i++, ii++) {
+        if (isCanceled())
+            return false;
+
+        TopLoc_Location aLoc;
+        const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
+        // get the mesh of the shape
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(actFace);
+        }
+        if (mesh.IsNull()) {
+            parts[ii] = 0;
+            continue;
+        }
+
+        // getting the transformation of the shape/face
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!aLoc.IsIdentity()) {
+            identity = false;
+            myTransf = aLoc.Transformation();
+        }
+
+        // getting size of node and triangle array of this face
+        int nbNodesInFace = mesh->NbNodes();
+        int nbTriInFace   = mesh->NbTriangles();
+        // check orientation
+        TopAbs_Orientation orient = actFace.Orientation();
+
+
+        // cycling through the poly mesh
+#if OCC_VERSION_HEX < 0x070600
+        const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
+        const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
+        TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
+#else
+        int numNodes =  mesh->NbNodes();
+        TColgp_Array1OfDir Normals (1, numNodes);
+#endif
+        if (normalsFromUV)
+            Part::Tools::getPointNormals(actFace, mesh, Normals);
+
+        for (int g=1;g<=nbTriInFace;g++) {
+            // Get the triangle
+            Standard_Integer N1,N2,N3;
+#if OCC_VERSION_HEX < 0x070600
+            Triangles(g).Get(N1,N2,N3);
+#else
+            mesh->Triangle(g).Get(N1,N2,N3);
+#endif
+
+            // change orientation of the triangle if the face is reversed
+            if ( orient != TopAbs_FORWARD ) {
+                Standard_Integer tmp = N1;
+                N1 = N2;
+                N2 = tmp;
+            }
+
+            // get the 3 points of this triangle
+#if OCC_VERSION_HEX < 0x070600
+            gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
+#else
+            gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
+#endif
+
+            // get the 3 normals of this triangle
+            gp_Vec NV1, NV2, NV3;
+            if (normalsFromUV) {
+                NV1.SetXYZ(Normals(N1).XYZ());
+                NV2.SetXYZ(Normals(N2).XYZ());
+                NV3.SetXYZ(Normals(N3).XYZ());
+            }
+            else {
+                gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
+                       v2(V2.X(),V2.Y(),V2.Z()),
+                       v3(V3.X(),V3.Y(),V3.Z());
+                gp_Vec normal = (v2-v1)^(v3-v1);
+                NV1 = normal;
+                NV2 = normal;
+                NV3 = normal;
+            }
+
+            // transform the vertices and normals to the place of the face
+            if (!identity) {
+                V1.Transform(myTransf);
+                V2.Transform(myTransf);
+                V3.Transform(myTransf);
+                if (normalsFromUV) {
+                    NV1.Transform(myTransf);
+                    NV2.Transform(myTransf);
+                    NV3.Transform(myTransf);
+                }
+            }
+
+            // add the normals for all points of this triangle
+            norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
+            norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
+            norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
+
+            // set the vertices
+            verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
+            verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
+            verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
+
+            // set the index vector with the 3 point indexes and the end delimiter
+            index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
+            index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
+            index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
+            index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
+        }
+
+        parts[ii] = nbTriInFace; // new part
+
+        // handling the edges lying on this face
+        TopExp_Explorer Exp;
+        for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
+            const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
+            // get the overall index of this edge
+            int edgeIndex = edgeMap.FindIndex(curEdge);
+            // already processed this index ?
+            if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
+
+                // this holds the indices of the edge's triangulation to the current polygon
+                Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
+                if (aPoly.IsNull())
+                    continue; // polygon does not exist
+
+                // getting the indexes of the edge polygon
+                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+                for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
+                    int nodeIndex = indices(i);
+                    int index = faceNodeOffset+nodeIndex-1;
+                    lineSetMap[edgeIndex].push_back(index);
+
+                    // usually the coordinates for this edge are already set by the
+                    // triangles of the face this edge belongs to. However, there are
+                    // rare cases where some points are only referenced by the polygon
+                    // but not by any triangle. Thus, we must apply the coordinates to
+                    // make sure that everything is properly set.
+#if OCC_VERSION_HEX < 0x070600
+                    gp_Pnt p(Nodes(nodeIndex));
+#else
+                    gp_Pnt p(mesh->Node(nodeIndex));
+#endif
+                    if (!identity)
+                        p.Transform(myTransf);
+                    verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
+                }
+
+                // remove the handled edge index from the set
+                edgeIdxSet.erase(edgeIndex);
+            }
+        }
+
+        // counting up the per Face offsets
+        faceNodeOffset += nbNodesInFace;
+        faceTriaOffset += nbTriInFace;
+    }
+
+    // handling of the free edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        Standard_Boolean identity = true;
+        gp_Trsf myTransf;
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        if (!faceEdges.count(aEdge)) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                if (!aLoc.IsIdentity()) {
+                    identity = false;
+                    myTransf = aLoc.Transformation();
+                }
+
+                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
+                int nbNodesInEdge = aPoly->NbNodes();
+
+                gp_Pnt pnt;
+                for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
+                    pnt = aNodes(j);
+                    if (!identity)
+                        pnt.Transform(myTransf);
+                    int index = faceNodeOffset+j-1;
+                    verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+                    lineSetMap[i].push_back(index);
+                }
+
+                faceNodeOffset += nbNodesInEdge;
+            }
+        }
+    }
+
+    if (isCanceled())
+        return false;
+
+    // handling of the vertices
+    TopTools_IndexedMapOfShape vertexMap;
+    TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
+
+    numPoints = vertexMap.Extent();
+    points.resize(numPoints);
+
+    for (int i=0; i<numPoints; i++) {
+        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
+        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
+        points[i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+    }
+
+    // normalize all normals
+    for (int i = 0; i< numNorms ;i++)
+        norms[i].normalize();
+
+    for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
+        lines.insert(lines.end(), it->second.begin(), it->second.end());
+        lines.push_back(-1);
+    }
+    numLines = lines.size();
+
+    duration = Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo());
+    return true;
+}
+
+#if OCC_VERSION_HEX >= 0x070500
+
+std::shared_ptr<VisualJob> VisualJob::start(const Part::TopoShape &shape,
+                                            VisualData &&data,
+                                            std::function<void(VisualJob &)> finished)
+{
+    auto job = std::make_shared<VisualJob>();
+    job->shape = shape;
+    job->data = std::move(data);
+    job->data.shape = BRepBuilderAPI_Copy(job->data.shape, Standard_False, Standard_True).Shape();
+
+    auto watcher = new QFutureWatcher<void>;
+    QObject::connect(watcher, &QFutureWatcher<void>::finished, watcher, [job, watcher, finished]() {
+        watcher->deleteLater();
+        if (!job->canceled)
+            finished(*job);
+    });
+    watcher->setFuture(QtConcurrent::run([job]() {
+        try {
+            if (!job->data.compute(&job->canceled))
+                job->canceled = true;
+        }
+        catch (Base::Exception &e) {
+            job->error = e.what();
+        }
+        catch (const Standard_Failure& e) {
+            job->error = e.GetMessageString();
+        }
+        catch (...) {
+            job->error = "unknown exception";
+        }
+    }));
+    return job;
+}
+
+void VisualJob::attachTessellation()
+{
+    const TopoDS_Shape &source = data.shape;
+    const TopoDS_Shape &target = shape.getShape();
+    if (source.IsNull() || target.IsNull())
+        return;
+
+    TopTools_IndexedMapOfShape sourceFaces, targetFaces, sourceEdges, targetEdges;
+    TopExp::MapShapes(source, TopAbs_FACE, sourceFaces);
+    TopExp::MapShapes(target, TopAbs_FACE, targetFaces);
+    TopExp::MapShapes(source, TopAbs_EDGE, sourceEdges);
+    TopExp::MapShapes(target, TopAbs_EDGE, targetEdges);
+    if (sourceFaces.Extent() != targetFaces.Extent()
+            || sourceEdges.Extent() != targetEdges.Extent())
+        return;
+
+    BRep_Builder builder;
+    for (int i=1; i<=sourceFaces.Extent(); ++i) {
+        const TopoDS_Face &face = TopoDS::Face(sourceFaces(i));
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+        if (mesh.IsNull())
+            continue;
+        builder.UpdateFace(TopoDS::Face(targetFaces(i)), mesh);
+
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const TopoDS_Edge &edge = TopoDS::Edge(xp.Current());
+            Handle(Poly_PolygonOnTriangulation) polygon = BRep_Tool::PolygonOnTriangulation(
+                    TopoDS::Edge(edge.Oriented(TopAbs_FORWARD)), mesh, loc);
+            if (polygon.IsNull())
+                continue;
+            // Seam edges have one polygon for each orientation
+            Handle(Poly_PolygonOnTriangulation) polygon2 = BRep_Tool::PolygonOnTriangulation(
+                    TopoDS::Edge(edge.Oriented(TopAbs_REVERSED)), mesh, loc);
+            const TopoDS_Edge &targetEdge = TopoDS::Edge(targetEdges(sourceEdges.FindIndex(edge)));
+            if (polygon2.IsNull() || polygon2 == polygon)
+                builder.UpdateEdge(targetEdge, polygon, mesh, loc);
+            else
+                builder.UpdateEdge(targetEdge, polygon, polygon2, mesh, loc);
+        }
+    }
+
+    // free edges
+    for (int i=1; i<=sourceEdges.Extent(); ++i) {
+        TopLoc_Location loc;
+        Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(TopoDS::Edge(sourceEdges(i)), loc);
+        if (!polygon.IsNull())
+            builder.UpdateEdge(TopoDS::Edge(targetEdges(i)), polygon, loc);
+    }
+}
+
+#endif // OCC_VERSION_HEX >= 0x070500
@@ -0,0 +1,132 @@
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association <www.freecad.org>       *
+ *                                                                          *
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+#ifndef PARTGUI_VISUALTESSELLATION_H
+#define PARTGUI_VISUALTESSELLATION_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Inventor/SbVec3f.h>
+#include <Standard_Version.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/PartGlobal.h>
+
+namespace PartGui
+{
+
+/** Tessellation of a shape as plain arrays
+ *
+ * It is computed without touching any Coin node, so that it can run outside
+ * of the GUI thread, and is then copied into the visual nodes of
+ * ViewProviderPartExt in one go.
+ */
+struct PartGuiExport VisualData
+{
+    TopoDS_Shape shape;
+    double deviation = 0.0;
+    double angularDeflection = 0.0;
+    bool normalsFromUV = false;
+
+    std::vector<SbVec3f> verts;
+    std::vector<SbVec3f> norms;
+    std::vector<SbVec3f> points;
+    std::vector<int32_t> index;
+    std::vector<int32_t> parts;
+    std::vector<int32_t> lines;
+    std::vector<int32_t> seams;
+
+    int numTriangles=0,numNodes=0,numPoints=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
+    double duration = 0.0;
+
+    bool sameParameters(const VisualData &other) const {
+        return deviation == other.deviation
+            && angularDeflection == other.angularDeflection
+            && normalsFromUV == other.normalsFromUV;
+    }
+
+    void clear() {
+        verts.clear();
+        norms.clear();
+        points.clear();
+        index.clear();
+        parts.clear();
+        lines.clear();
+        seams.clear();
+    }
+
+    /// Tessellate the shape, return false if canceled
+    bool compute(const std::atomic<bool> *canceled = nullptr);
+};
+
+/** Tessellation of a shape in a worker thread
+ *
+ * Only available with OCCT 7.5 or later, which can abort the meshing.
+ *
+ * The job tessellates a copy of the topology (sharing the geometry), so that
+ * it does not race with any other access of the shape in the calling thread.
+ * The copy has the same sub-shape order, so the element indices of the result
+ * are still valid for the original shape.
+ */
+struct PartGuiExport VisualJob
+{
+    /// The original shape
+    Part::TopoShape shape;
+    /// Tessellation parameters and result, VisualData::shape holds the copy
+    VisualData data;
+    std::atomic<bool> canceled {false};
+    std::string error;
+    bool showBoundBox = false;
+
+#if OCC_VERSION_HEX >= 0x070500
+    /** Start tessellating the shape in a worker thread
+     *
+     * @param shape: the shape to tessellate
+     * @param data: the tessellation parameters
+     * @param finished: called in the thread of the caller once the job is
+     *                  done, unless it has been canceled before.
+     *
+     * @return Returns the started job. Must be called in a thread with an
+     * event loop.
+     */
+    static std::shared_ptr<VisualJob> start(const Part::TopoShape &shape,
+                                            VisualData &&data,
+                                            std::function<void(VisualJob &)> finished);
+
+    /** Attach the tessellation to the original shape
+     *
+     * Copies the triangulation of the faces and the polygons of the edges
+     * from the tessellated copy, so that the original shape does not need
+     * to be meshed again. Must be called in the thread owning the shape.
+     */
+    void attachTessellation();
+#endif
+};
+
+} // namespace PartGui
+
+#endif // PARTGUI_VISUALTESSELLATION_H
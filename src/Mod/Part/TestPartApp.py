@@ -23,11 +23,14 @@
 import FreeCAD, unittest, Part
 import copy
 import math
+import os
+import tempfile
 from FreeCAD import Units
 from FreeCAD import Base
 App = FreeCAD
 
 from parttests.regression_tests import RegressionTests
+from parttests import shape_factories
 
 #---------------------------------------------------------------------------
 # define the test cases to test the FreeCAD Part module
@@ -66,6 +69,331 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testParallelAndLazyRestore(self):
+        for i in range(10):
+            box = self.Doc.addObject("Part::Box","Box")
+            box.Length = i + 1
+        self.Doc.recompute()
+        fileName = tempfile.gettempdir() + os.sep + "PartTestRestore.FCStd"
+        self.Doc.saveCopy(fileName)
+
+        docParam = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        partParam = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        parallel = docParam.GetBool("ParallelRestore", False)
+        lazy = partParam.GetBool("LazyRestore", False)
+        try:
+            for lazyRestore in (False, True):
+                docParam.SetBool("ParallelRestore", True)
+                partParam.SetBool("LazyRestore", lazyRestore)
+                doc = FreeCAD.openDocument(fileName)
+                try:
+                    for obj, orig in zip(doc.Objects, self.Doc.Objects):
+                        self.assertEqual(obj.Name, orig.Name)
+                        self.assertAlmostEqual(obj.Shape.Volume, orig.Shape.Volume)
+                        self.assertEqual(len(obj.Shape.Faces), 6)
+                finally:
+                    FreeCAD.closeDocument(doc.Name)
+        finally:
+            docParam.SetBool("ParallelRestore", parallel)
+            partParam.SetBool("LazyRestore", lazy)
+
+    def testDeduplicateShapes(self):
+        import zipfile
+        box = Part.makeBox(2, 3, 4).makeFillet(0.5, Part.makeBox(2, 3, 4).Edges)
+        for i in range(5):
+            self.Doc.addObject("Part::Feature", "Copy").Shape = box.copy()
+        self.Doc.addObject("Part::Feature", "Other").Shape = Part.makeSphere(2)
+        fileName = tempfile.gettempdir() + os.sep + "PartTestDedup.FCStd"
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        dedup = param.GetBool("DeduplicateShapes", False)
+        param.SetBool("DeduplicateShapes", True)
+        try:
+            self.Doc.saveCopy(fileName)
+        finally:
+            param.SetBool("DeduplicateShapes", dedup)
+
+        with zipfile.ZipFile(fileName) as zf:
+            sizes = sorted(info.file_size for info in zf.infolist()
+                           if info.filename.endswith('.brp'))
+        self.assertEqual(len(sizes), 6)
+        # four references, the original box and the sphere
+        self.assertTrue(all(size < 100 for size in sizes[:4]))
+        self.assertTrue(all(size > 1000 for size in sizes[4:]))
+
+        doc = FreeCAD.openDocument(fileName)
+        try:
+            copies = [obj for obj in doc.Objects if obj.Name.startswith('Copy')]
+            self.assertEqual(len(copies), 5)
+            for obj in copies:
+                self.assertAlmostEqual(obj.Shape.Volume, box.Volume)
+                self.assertTrue(obj.Shape.isPartner(copies[0].Shape))
+            self.assertFalse(doc.Other.Shape.isPartner(copies[0].Shape))
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    def testSaveTessellation(self):
+        import zipfile
+        sphere = self.Doc.addObject("Part::Feature", "Sphere")
+        sphere.Shape = Part.makeSphere(5)
+        fine = len(sphere.Shape.tessellate(0.01)[0])
+        fileName = tempfile.gettempdir() + os.sep + "PartTestTessellation.FCStd"
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        saveTessellation = param.GetBool("SaveTessellation", False)
+        try:
+            for enable in (False, True):
+                param.SetBool("SaveTessellation", enable)
+                self.Doc.saveCopy(fileName)
+                with zipfile.ZipFile(fileName) as zf:
+                    meshes = [info.filename for info in zf.infolist()
+                              if info.filename.endswith('.Mesh')]
+                self.assertEqual(len(meshes), 1 if enable else 0)
+
+                doc = FreeCAD.openDocument(fileName)
+                try:
+                    # The restored triangulation is finer than requested, and
+                    # therefore reused without meshing again
+                    count = len(doc.Sphere.Shape.tessellate(1.0)[0])
+                    if enable:
+                        self.assertEqual(count, fine)
+                    else:
+                        self.assertLess(count, fine)
+                finally:
+                    FreeCAD.closeDocument(doc.Name)
+        finally:
+            param.SetBool("SaveTessellation", saveTessellation)
+
+    def testIncrementalSaveTessellation(self):
+        import zipfile
+        sphere = self.Doc.addObject("Part::Feature", "Sphere")
+        sphere.Shape = Part.makeSphere(5)
+        sphere.Shape.tessellate(1.0)
+        fileName = tempfile.gettempdir() + os.sep + "PartTestIncremental.FCStd"
+
+        def meshCrc():
+            with zipfile.ZipFile(fileName) as zf:
+                return [info.CRC for info in zf.infolist() if info.filename.endswith('.Mesh')]
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        docParam = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        saveTessellation = param.GetBool("SaveTessellation", False)
+        incremental = docParam.GetBool("IncrementalSave", False)
+        backup = docParam.GetBool("BackupPolicy", True)
+        param.SetBool("SaveTessellation", True)
+        docParam.SetBool("IncrementalSave", True)
+        docParam.SetBool("BackupPolicy", True)
+        try:
+            self.Doc.saveAs(fileName)
+            crc = meshCrc()
+            self.assertEqual(len(crc), 1)
+            self.Doc.save()
+            reused = self.Doc.ReusedFileCount
+            self.assertGreater(reused, 0)
+            self.assertEqual(meshCrc(), crc)
+
+            # Meshing again does not touch the property, but must not reuse
+            # the shape files saved before
+            sphere.Shape.tessellate(0.01)
+            self.Doc.save()
+            self.assertLess(self.Doc.ReusedFileCount, reused)
+            self.assertNotEqual(meshCrc(), crc)
+        finally:
+            param.SetBool("SaveTessellation", saveTessellation)
+            docParam.SetBool("IncrementalSave", incremental)
+            docParam.SetBool("BackupPolicy", backup)
+
+    def testBinaryBrep(self):
+        import zipfile
+        shapes = shape_factories.makeReferenceShapes(1)
+        for binary in (False, True):
+            fileName = tempfile.gettempdir() + os.sep + "PartTestBrep.FCStd"
+            doc = FreeCAD.newDocument("PartTestBrep")
+            try:
+                doc.PreferBinary = binary
+                for name, shape in shapes:
+                    doc.addObject("Part::Feature", name).Shape = shape
+                doc.saveCopy(fileName)
+            finally:
+                FreeCAD.closeDocument(doc.Name)
+
+            extension = '.bin' if binary else '.brp'
+            with zipfile.ZipFile(fileName) as zf:
+                files = [info.filename for info in zf.infolist()
+                         if info.filename.endswith(extension)]
+            self.assertEqual(len(files), len(shapes))
+
+            doc = FreeCAD.openDocument(fileName)
+            try:
+                for obj, (name, shape) in zip(doc.Objects, shapes):
+                    self.assertTrue(obj.Name.startswith(name))
+                    self.assertEqual(len(obj.Shape.Faces), len(shape.Faces))
+                    self.assertAlmostEqual(obj.Shape.Area, shape.Area, 6)
+            finally:
+                FreeCAD.closeDocument(doc.Name)
+
+    def testElementMapMemSize(self):
+        last = shape_factories.makeFeatureChain(self.Doc, 6)
+        self.Doc.recompute()
+        shape = last.Shape
+        self.assertGreater(shape.ElementMapSize, 0)
+        self.assertGreater(shape.ElementMapMemSize, 0)
+
+        fileName = tempfile.gettempdir() + os.sep + "PartTestElementMap.FCStd"
+        self.Doc.saveCopy(fileName)
+        doc = FreeCAD.openDocument(fileName)
+        try:
+            self.assertEqual(doc.getObject(last.Name).Shape.ElementMapSize, shape.ElementMapSize)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+        for i in range(len(shape.Faces)):
+            name = 'Face%d' % (i+1)
+            mapped = shape.getElementMappedName(name)
+            self.assertTrue(mapped)
+            self.assertEqual(shape.getElementIndexedName(';' + mapped), name)
+
+    def testMemoryReport(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        info = [o for o in self.Doc.memoryReport()['Objects'] if o['Name'] == box.Name][0]
+        self.assertGreater(info['Categories']['BRep'], 0)
+        box.Shape.tessellate(0.1)
+        info = [o for o in self.Doc.memoryReport()['Objects'] if o['Name'] == box.Name][0]
+        self.assertGreater(info['Categories']['Triangulation'], 0)
+
+    def testMemoryReportPendingElementMap(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        lazy = param.GetBool("LazyElementMap", False)
+        param.SetBool("LazyElementMap", True)
+        try:
+            last = shape_factories.makeFeatureChain(self.Doc, 2)
+            self.Doc.recompute()
+            # Measuring must not generate the element map
+            for _ in range(2):
+                info = [o for o in self.Doc.memoryReport()['Objects'] if o['Name'] == last.Name][0]
+                self.assertGreater(info['Categories']['PendingElementMap'], 0)
+                self.assertNotIn('ElementMap', info['Categories'])
+        finally:
+            param.SetBool("LazyElementMap", lazy)
+
+    def testBooleanCache(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        cacheSize = param.GetInt("BooleanCacheSize", 0)
+        param.SetInt("BooleanCacheSize", 16)
+        try:
+            box1 = self.Doc.addObject("Part::Box","Box")
+            box2 = self.Doc.addObject("Part::Box","Box")
+            box2.Placement.Base = FreeCAD.Vector(5,5,5)
+            fuse = self.Doc.addObject("Part::MultiFuse","Fuse")
+            fuse.Shapes = [box1, box2]
+            self.Doc.recompute()
+            shape = fuse.Shape
+
+            # unchanged input reuses the memoized result, including the element map
+            fuse.touch()
+            self.Doc.recompute()
+            self.assertTrue(fuse.Shape.isPartner(shape))
+            self.assertEqual(sorted(fuse.Shape.ElementMap.items()), sorted(shape.ElementMap.items()))
+
+            box2.Length = 20
+            self.Doc.recompute()
+            self.assertFalse(fuse.Shape.isPartner(shape))
+            self.assertGreater(fuse.Shape.Volume, shape.Volume)
+        finally:
+            param.SetInt("BooleanCacheSize", cacheSize)
+
+    def testBooleanClusters(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        threshold = param.GetInt("BooleanClusterThreshold", 0)
+        try:
+            base, tools = shape_factories.makePlates(3, 4)
+            results = []
+            for value in (0, 2):
+                param.SetInt("BooleanClusterThreshold", value)
+                results.append(base.cut(tools))
+            self.assertAlmostEqual(results[0].Volume, results[1].Volume, 6)
+            self.assertEqual(len(results[0].Faces), len(results[1].Faces))
+
+            # tools outside of the plates are dropped
+            base, tools = shape_factories.makePlates(2, 4)
+            tools.append(Part.makeBox(1, 1, 1, FreeCAD.Vector(-10, -10, -10)))
+            res = base.cut(tools)
+        finally:
+            param.SetInt("BooleanClusterThreshold", threshold)
+        self.assertAlmostEqual(res.Volume, results[0].Volume * 2 / 3, 6)
+        self.assertEqual(len(res.Solids), 2)
+
+    def testLazyElementMap(self):
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        lazy = param.GetBool("LazyElementMap", False)
+        names = []
+        try:
+            for lazyElementMap in (False, True):
+                param.SetBool("LazyElementMap", lazyElementMap)
+                doc = FreeCAD.newDocument("PartTestLazy")
+                try:
+                    last = shape_factories.makeFeatureChain(doc, 6)
+                    doc.recompute()
+                    shape = last.Shape
+                    names.append(sorted(shape.ElementMap.items()))
+                finally:
+                    FreeCAD.closeDocument(doc.Name)
+        finally:
+            param.SetBool("LazyElementMap", lazy)
+        self.assertTrue(names[0])
+        self.assertEqual(names[0], names[1])
+
+    def testParallelRecompute(self):
+        import json, re
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        parallel = param.GetBool("ParallelRecompute", False)
+        tracePath = tempfile.gettempdir() + os.sep + "PartParallelRecompute.json"
+        pattern = re.compile(r'#([0-9a-fA-F]+)(?::(\d+))?')
+
+        def elementMap(doc, shape):
+            # The string IDs are assigned in the order of recompute, so
+            # compare the hashed strings instead
+            def resolve(match):
+                text = doc.Hasher.getID(int(match.group(1), 16)).Data
+                return '{%s}%s' % (pattern.sub(resolve, text), match.group(2) or '')
+            return sorted((pattern.sub(resolve, k), v) for k, v in shape.ElementMap.items())
+
+        maps = []
+        try:
+            for parallelRecompute in (False, True):
+                param.SetBool("ParallelRecompute", parallelRecompute)
+                doc = FreeCAD.newDocument("PartTestParallel")
+                try:
+                    fuses = []
+                    for _ in range(2):
+                        fuse = doc.addObject("Part::Fuse","Fuse")
+                        fuse.Base = doc.addObject("Part::Box","Box")
+                        fuse.Tool = doc.addObject("Part::Box","Box")
+                        fuse.Tool.Placement = FreeCAD.Placement(FreeCAD.Vector(5,5,5), FreeCAD.Rotation())
+                        fuses.append(fuse)
+                    # object with expression must stay in the main thread
+                    box = doc.addObject("Part::Box","Box")
+                    box.setExpression('Length', '20')
+
+                    doc.recomputeProfile(None, False, tracePath)
+                    with open(tracePath) as f:
+                        trace = json.load(f)
+                    os.remove(tracePath)
+                    threads = dict((e['args']['object'], e['tid']) for e in trace['traceEvents']
+                                   if e['cat'] == 'recompute')
+                    mainThread = threads[box.FullName]
+                    for fuse in fuses:
+                        self.assertTrue(fuse.isValid())
+                        self.assertEqual(threads[fuse.FullName] != mainThread, parallelRecompute)
+                    maps.append([elementMap(doc, fuse.Shape) for fuse in fuses])
+                finally:
+                    FreeCAD.closeDocument(doc.Name)
+        finally:
+            param.SetBool("ParallelRecompute", parallel)
+        self.assertTrue(maps[0][0])
+        self.assertEqual(maps[0], maps[1])
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -57,6 +57,44 @@ class PartGuiViewProviderTestCases(unittest.TestCase):
         with self.assertRaises(TypeError):
             box.ViewObject.dropObject(box, 0)
 
+    def testBackgroundTessellationWhileHidden(self):
+        import time
+        from pivy import coin
+
+        def maxX(vobj):
+            action = coin.SoSearchAction()
+            action.setType(coin.SoCoordinate3.getClassTypeId())
+            action.setInterest(coin.SoSearchAction.ALL)
+            action.apply(vobj.RootNode)
+            paths = action.getPaths()
+            return max([p[0] for i in range(paths.getLength())
+                        for p in paths[i].getTail().point.getValues()] + [0.0])
+
+        def waitFor(condition, timeout=10.0):
+            end = time.time() + timeout
+            while not condition() and time.time() < end:
+                FreeCADGui.updateGui()
+                time.sleep(0.05)
+            FreeCADGui.updateGui()
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+        threshold = param.GetInt("AsyncTessellationThreshold", 1000)
+        param.SetInt("AsyncTessellationThreshold", 1)
+        try:
+            obj = self.Doc.addObject("Part::Feature", "Shape")
+            obj.Shape = Part.makeBox(1, 1, 1)
+            # Change the shape while hidden and while the first job is running
+            obj.ViewObject.Visibility = False
+            obj.Shape = Part.makeBox(10, 10, 10)
+            waitFor(lambda: False, 1.0)
+
+            # The result of the first job must not be shown
+            obj.ViewObject.Visibility = True
+            waitFor(lambda: maxX(obj.ViewObject) > 5)
+            self.assertAlmostEqual(maxX(obj.ViewObject), 10, 3)
+        finally:
+            param.SetInt("AsyncTessellationThreshold", threshold)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartGuiTest")
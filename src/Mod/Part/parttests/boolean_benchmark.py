@@ -0,0 +1,58 @@
+"""Benchmark of boolean operations with many tool shapes
+
+A row of plates is cut by a grid of cylindrical fasteners, all passed to a
+single cut operation. The same cut is timed with and without the clustering
+of spatially independent input shapes (see Part parameter
+BooleanClusterThreshold), and the volume and face count of the results are
+reported so that the two can be compared.
+"""
+
+import time
+
+import FreeCAD
+
+from parttests.shape_factories import makePlates
+
+
+def benchmarkCut(plates, toolsPerPlate, threshold):
+    """Cuts the plates with the given cluster threshold
+
+    Returns a dictionary with the cut time in seconds, and the volume and
+    face count of the result.
+    """
+    base, tools = makePlates(plates, toolsPerPlate)
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+    oldThreshold = param.GetInt("BooleanClusterThreshold", 0)
+    oldCacheSize = param.GetInt("BooleanCacheSize", 0)
+    param.SetInt("BooleanClusterThreshold", threshold)
+    # Do not measure the memoized result
+    param.SetInt("BooleanCacheSize", 0)
+    try:
+        start = time.perf_counter()
+        res = base.cut(tools)
+        elapsed = time.perf_counter() - start
+    finally:
+        param.SetInt("BooleanClusterThreshold", oldThreshold)
+        param.SetInt("BooleanCacheSize", oldCacheSize)
+    return {'Tools': len(tools),
+            'Threshold': threshold,
+            'Time': elapsed,
+            'Volume': res.Volume,
+            'Faces': len(res.Faces)}
+
+
+def run(plates=20, toolsPerPlate=50):
+    """Runs the benchmark and prints the result with and without clustering"""
+    results = [benchmarkCut(plates, toolsPerPlate, threshold) for threshold in (0, 2)]
+
+    FreeCAD.Console.PrintMessage('Boolean cluster benchmark\n')
+    FreeCAD.Console.PrintMessage('%8s %10s %10s %14s %8s\n'
+            % ('Tools', 'Threshold', 'Time(s)', 'Volume', 'Faces'))
+    for res in results:
+        FreeCAD.Console.PrintMessage('%8d %10d %10.4f %14.4f %8d\n'
+                % (res['Tools'], res['Threshold'], res['Time'], res['Volume'], res['Faces']))
+    return results
+
+
+if __name__ == '__main__':
+    run()
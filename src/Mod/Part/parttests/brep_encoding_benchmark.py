@@ -0,0 +1,81 @@
+"""Benchmark of the B-rep encodings used to store Part shapes in FCStd files
+
+The shapes are stored either as OCCT text B-rep (.brp), or as OCCT binary
+B-rep (.bin) when the document property PreferBinary is set. The parameter
+'User parameter:BaseApp/Preferences/Document/PreferBinary' sets the default
+of new documents.
+"""
+
+import os
+import tempfile
+import time
+import zipfile
+
+import FreeCAD
+
+from parttests.shape_factories import makeReferenceShapes
+
+
+def benchmarkEncoding(shapes, binary, repeat=3, tempDir=None):
+    """Saves and restores a document containing the given shapes
+
+    Returns a dictionary with the file size, the uncompressed size of the
+    shape files and the best save and restore time in seconds.
+    """
+    if not tempDir:
+        tempDir = tempfile.gettempdir()
+    fileName = os.path.join(tempDir, 'BrepBenchmark%s.FCStd' % ('Bin' if binary else 'Brp'))
+    extension = '.bin' if binary else '.brp'
+
+    doc = FreeCAD.newDocument('BrepBenchmark')
+    try:
+        doc.PreferBinary = binary
+        for name, shape in shapes:
+            doc.addObject('Part::Feature', name).Shape = shape
+        saveTime = None
+        for _ in range(repeat):
+            start = time.perf_counter()
+            doc.saveCopy(fileName)
+            elapsed = time.perf_counter() - start
+            saveTime = elapsed if saveTime is None else min(saveTime, elapsed)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    with zipfile.ZipFile(fileName) as zf:
+        payload = sum(info.file_size for info in zf.infolist()
+                      if info.filename.endswith(extension))
+
+    restoreTime = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        doc = FreeCAD.openDocument(fileName)
+        elapsed = time.perf_counter() - start
+        restoreTime = elapsed if restoreTime is None else min(restoreTime, elapsed)
+        FreeCAD.closeDocument(doc.Name)
+
+    return {'FileSize': os.path.getsize(fileName),
+            'PayloadSize': payload,
+            'SaveTime': saveTime,
+            'RestoreTime': restoreTime,
+            'FileName': fileName}
+
+
+def run(repeat=3, count=4):
+    """Runs the benchmark and prints the result of both encodings"""
+    shapes = makeReferenceShapes(count)
+    results = {}
+    for binary in (False, True):
+        results['Binary' if binary else 'Text'] = benchmarkEncoding(shapes, binary, repeat)
+
+    FreeCAD.Console.PrintMessage('B-rep encoding benchmark, %d shapes\n' % len(shapes))
+    FreeCAD.Console.PrintMessage('%-8s %12s %12s %10s %10s\n'
+            % ('Encoding', 'File', 'Payload', 'Save(s)', 'Load(s)'))
+    for name, res in results.items():
+        FreeCAD.Console.PrintMessage('%-8s %12d %12d %10.4f %10.4f\n'
+                % (name, res['FileSize'], res['PayloadSize'],
+                   res['SaveTime'], res['RestoreTime']))
+    return results
+
+
+if __name__ == '__main__':
+    run()
@@ -0,0 +1,83 @@
+"""Benchmark of the topological element map of Part shapes
+
+Feature chains of increasing length are built in a document, where each
+step fuses or cuts one more primitive into the result of the previous
+step. The element map of the final shape therefore grows with the chain
+length, and references the maps of all the earlier steps.
+
+For each chain the recompute time, the number of mapped names and the
+estimated memory of the element map are reported, both after recompute
+and after the document has been saved and restored.
+"""
+
+import os
+import tempfile
+import time
+
+import FreeCAD
+
+from parttests.shape_factories import makeFeatureChain
+
+
+def measure(shape):
+    return shape.ElementMapSize, shape.ElementMapMemSize
+
+
+def benchmarkChain(length, tempDir=None):
+    """Builds, saves and restores a feature chain of the given length
+
+    Returns a dictionary with the recompute and restore time in seconds,
+    and the element map size and memory of the final shape.
+    """
+    if not tempDir:
+        tempDir = tempfile.gettempdir()
+    fileName = os.path.join(tempDir, 'ElementMapBenchmark%d.FCStd' % length)
+
+    doc = FreeCAD.newDocument('ElementMapBenchmark')
+    try:
+        last = makeFeatureChain(doc, length)
+        start = time.perf_counter()
+        doc.recompute()
+        recomputeTime = time.perf_counter() - start
+        mapSize, memSize = measure(last.Shape)
+        faces = len(last.Shape.Faces)
+        lastName = last.Name
+        doc.saveAs(fileName)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    start = time.perf_counter()
+    doc = FreeCAD.openDocument(fileName)
+    restoreTime = time.perf_counter() - start
+    try:
+        restoredSize, restoredMemSize = measure(doc.getObject(lastName).Shape)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    return {'Length': length,
+            'Faces': faces,
+            'RecomputeTime': recomputeTime,
+            'RestoreTime': restoreTime,
+            'MapSize': mapSize,
+            'MemSize': memSize,
+            'RestoredMapSize': restoredSize,
+            'RestoredMemSize': restoredMemSize,
+            'FileName': fileName}
+
+
+def run(lengths=(10, 40, 160)):
+    """Runs the benchmark and prints the result of each chain length"""
+    results = [benchmarkChain(length) for length in lengths]
+
+    FreeCAD.Console.PrintMessage('Element map benchmark\n')
+    FreeCAD.Console.PrintMessage('%8s %8s %10s %10s %10s %12s %12s\n'
+            % ('Length', 'Faces', 'Build(s)', 'Load(s)', 'Names', 'Memory', 'Loaded'))
+    for res in results:
+        FreeCAD.Console.PrintMessage('%8d %8d %10.4f %10.4f %10d %12d %12d\n'
+                % (res['Length'], res['Faces'], res['RecomputeTime'], res['RestoreTime'],
+                   res['MapSize'], res['MemSize'], res['RestoredMemSize']))
+    return results
+
+
+if __name__ == '__main__':
+    run()
@@ -0,0 +1,78 @@
+"""Shapes and documents shared by the Part unit tests and benchmarks"""
+
+import math
+
+import Part
+from FreeCAD import Vector
+
+
+def makePlates(plates, toolsPerPlate):
+    """Returns a compound of plates and a list of fasteners, where each plate
+    is cut by toolsPerPlate fasteners"""
+    rows = max(1, int(toolsPerPlate ** 0.5))
+    cols = (toolsPerPlate + rows - 1) // rows
+    solids = []
+    tools = []
+    for p in range(plates):
+        x0 = p * (cols * 4 + 10)
+        solids.append(Part.makeBox(cols * 4 + 4, rows * 4 + 4, 5, Vector(x0, 0, 0)))
+        for i in range(toolsPerPlate):
+            pos = Vector(x0 + (i % cols) * 4 + 4, (i // cols) * 4 + 4, -1)
+            tools.append(Part.makeCylinder(1, 7, pos))
+    return Part.makeCompound(solids), tools
+
+
+def makeReferenceShapes(count=4):
+    """Returns a list of (name, shape) covering analytic, free form and
+    boolean geometry"""
+    shapes = []
+    for i in range(count):
+        box = Part.makeBox(10 + i, 10, 10)
+        shapes.append(('Box', box))
+        shapes.append(('Fillet', box.makeFillet(1.5, box.Edges)))
+
+        cylinder = Part.makeCylinder(3, 20, Vector(5, 5, -5))
+        shapes.append(('Cut', box.cut(cylinder)))
+
+        points = [[Vector(x, y, math.sin(x * 0.7 + i) * math.cos(y * 0.5) * 3)
+                   for y in range(12)] for x in range(12)]
+        surface = Part.BSplineSurface()
+        surface.interpolate(points)
+        shapes.append(('BSplineFace', surface.toShape()))
+
+        profile1 = Part.Wire(Part.makeCircle(5, Vector(0, 0, 0)))
+        profile2 = Part.Wire(Part.makePolygon([Vector(-4, -4, 10), Vector(4, -4, 10),
+                                               Vector(4, 4, 10), Vector(-4, 4, 10),
+                                               Vector(-4, -4, 10)]))
+        shapes.append(('Loft', Part.makeLoft([profile1, profile2], True)))
+
+        spheres = [Part.makeSphere(2, Vector(j * 3, 0, 0)) for j in range(4)]
+        shapes.append(('Fusion', spheres[0].fuse(spheres[1:]).removeSplitter()))
+    return shapes
+
+
+def makeFeatureChain(doc, length):
+    """Adds a chain of boolean features to the document and returns the
+    last feature"""
+    base = doc.addObject('Part::Box', 'Base')
+    base.Length = length * 4 + 4
+    base.Width = 10
+    base.Height = 10
+    for i in range(length):
+        if i % 2:
+            tool = doc.addObject('Part::Cylinder', 'Hole')
+            tool.Radius = 1.5
+            tool.Height = 20
+            tool.Placement.Base = Vector(i * 4 + 2, 5, -5)
+            feature = doc.addObject('Part::Cut', 'Cut')
+        else:
+            tool = doc.addObject('Part::Box', 'Rib')
+            tool.Length = 2
+            tool.Width = 12
+            tool.Height = 3
+            tool.Placement.Base = Vector(i * 4 + 1, -1, 8)
+            feature = doc.addObject('Part::Fuse', 'Fuse')
+        feature.Base = base
+        feature.Tool = tool
+        base = feature
+    return base
@@ -33,6 +33,11 @@
 # include <TopExp_Explorer.hxx>
 #endif
 
+#include <Standard_Version.hxx>
+#if OCC_VERSION_HEX >= 0x070000
+# include <OSD_Parallel.hxx>
+#endif
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/MappedElement.h>
@@ -451,6 +456,56 @@ App::DocumentObjectExecReturn *Transformed::execute()
         return App::DocumentObject::StdReturn; // No transformations defined, exit silently
     }
 
+    auto skipInstance = [&](std::size_t idx) {
+        // Skip first transformation in case we do not transform the first
+        // instance (i.e. original feature belongs to the same sibling group)
+        return idx == 0 && canSkipFirst && (_Version.getValue()==0 || !hasOffset);
+    };
+
+    // Copying the shapes is independent of each other, so do it up front in
+    // parallel. The element mapping below stays serial to keep the generated
+    // names stable.
+    std::vector<std::vector<TopoDS_Shape> > shapeCopies(originalShapes.size());
+    if (CopyShape.getValue()) {
+        std::vector<std::pair<std::size_t, std::size_t> > jobs;
+        for (std::size_t i=0; i<originalShapes.size(); ++i) {
+            if (originalShapes[i].isNull())
+                continue;
+            shapeCopies[i].resize(transformations.size());
+            for (std::size_t idx=startIndices[i]; idx<transformations.size(); ++idx) {
+                if (!skipInstance(idx))
+                    jobs.emplace_back(i, idx);
+            }
+        }
+        auto copyJob = [&](int k) {
+            const auto &job = jobs[k];
+            try {
+                shapeCopies[job.first][job.second] =
+                    BRepBuilderAPI_Copy(originalShapes[job.first].getShape()).Shape();
+            } catch (Standard_Failure &) {
+                // leave it empty, the shape is copied again below to report the error
+            }
+        };
+#if OCC_VERSION_HEX >= 0x070000
+        OSD_Parallel::For(0, static_cast<int>(jobs.size()), copyJob, jobs.size() < 2);
+#else
+        for (int k=0; k<static_cast<int>(jobs.size()); ++k)
+            copyJob(k);
+#endif
+    }
+    auto getShapeCopy = [&](std::size_t i, std::size_t idx) {
+        const auto &shape = originalShapes[i];
+        if (!CopyShape.getValue())
+            return shape;
+        if (idx < shapeCopies[i].size() && !shapeCopies[i][idx].IsNull()) {
+            TopoShape res(shape);
+            res.setShape(shapeCopies[i][idx], false);
+            shapeCopies[i][idx].Nullify();
+            return res;
+        }
+        return shape.makECopy();
+    };
+
     std::ostringstream ss;
 
     TopoShape result;
@@ -571,7 +626,7 @@ App::DocumentObjectExecReturn *Transformed::execute()
         for (const TopoShape &shape : originalShapes) {
             auto &sub = originalSubs[i];
             int idx = startIndices[i];
-            auto op = operations[i++];
+            auto op = operations[i];
             if (op != lastop) {
                 lastop = op;
                 buildShape();
@@ -581,17 +636,13 @@ App::DocumentObjectExecReturn *Transformed::execute()
                 ss.str("");
                 if (idx)
                     ss << 'I' << idx;
-                auto shapeCopy = CopyShape.getValue()?shape.makECopy():shape;
+                if (skipInstance(idx))
+                    continue;
+                auto shapeCopy = getShapeCopy(i, idx);
                 if (shapeCopy.isNull())
                     return new App::DocumentObjectExecReturn("Transformed: Linked shape object is empty");
                 try {
                     shapeCopy = shapeCopy.makETransform(*t, ss.str().c_str());
-                    if (idx == 0 && canSkipFirst && (_Version.getValue()==0 || !hasOffset)) {
-                        // Skip first transformation in case we do not transform the
-                        // first instance (i.e. original feature belongs to the same
-                        // sibling group)
-                        continue; 
-                    }
                     switch(op) {
                     case Additive:
                         fuseShapes.push_back(shapeCopy);
@@ -612,6 +663,7 @@ App::DocumentObjectExecReturn *Transformed::execute()
                     return new App::DocumentObjectExecReturn(msg.c_str());
                 }
             }
+            ++i;
         }
 
         buildShape();
@@ -628,7 +680,7 @@ App::DocumentObjectExecReturn *Transformed::execute()
     for (TopoShape &shape : originalShapes) {
         auto &sub = originalSubs[i];
         int idx = startIndices[i];
-        auto op = operations[i++];
+        auto op = operations[i];
 
         // Transform the add/subshape and collect the resulting shapes for overlap testing
         /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
@@ -637,16 +689,12 @@ App::DocumentObjectExecReturn *Transformed::execute()
 
         std::vector<gp_Trsf>::const_iterator t = transformations.begin() + idx;
         for (; t != transformations.end(); ++t,++idx) {
-            auto shapeCopy = CopyShape.getValue()?shape.makECopy():shape;
+            if (skipInstance(idx))
+                continue;
+            auto shapeCopy = getShapeCopy(i, idx);
             if (shapeCopy.isNull())
                 return new App::DocumentObjectExecReturn("Transformed: Linked shape object is empty");
 
-            if (idx == 0 && canSkipFirst && (_Version.getValue()==0 || !hasOffset)) {
-                // Skip first transformation in case we do not transform the
-                // first instance (i.e. original feature belongs to the same
-                // sibling group)
-                continue; 
-            }
             if (idx) {
                 ss.str("");
                 ss << 'I' << idx;
@@ -720,6 +768,7 @@ App::DocumentObjectExecReturn *Transformed::execute()
                 return new App::DocumentObjectExecReturn(msg.c_str());
             }
         }
+        ++i;
     }
 
     if (addsub.size() == 0)
@@ -19,6 +19,7 @@
 #*                                                                         *
 #***************************************************************************
 
+import math
 import unittest
 
 import FreeCAD
@@ -139,6 +140,37 @@ class TestPolarPattern(unittest.TestCase):
         self.Doc.recompute()
         self.assertAlmostEqual(self.PolarPattern.Shape.Volume, 4000)
 
+    def testManyOccurrencesPolarPattern(self):
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=100.00
+        self.Box.Width=100.00
+        self.Box.Height=10.00
+        self.Box.Placement.Base = FreeCAD.Vector(-50,-50,0)
+        self.Cylinder = self.Doc.addObject('PartDesign::SubtractiveCylinder','Cylinder')
+        self.Body.addObject(self.Cylinder)
+        self.Cylinder.Radius = 2
+        self.Cylinder.Height = 10
+        self.Cylinder.Placement.Base = FreeCAD.Vector(30,0,0)
+        self.Doc.recompute()
+        self.PolarPattern = self.Doc.addObject("PartDesign::PolarPattern","PolarPattern")
+        self.PolarPattern.Originals = [self.Cylinder]
+        self.PolarPattern.Axis = (self.Doc.Z_Axis,[""])
+        self.PolarPattern.Angle = 360
+        self.PolarPattern.Occurrences = 36
+        self.Body.addObject(self.PolarPattern)
+        self.Doc.recompute()
+        volume = 100*100*10 - 36*math.pi*4*10
+        self.assertAlmostEqual(self.PolarPattern.Shape.Volume, volume, places=3)
+        self.assertEqual(len(self.PolarPattern.Shape.Faces), 6 + 36)
+
+        # the serial path shall give the same result
+        self.PolarPattern.ParallelTransform = False
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.PolarPattern.Shape.Volume, volume, places=3)
+        self.assertEqual(len(self.PolarPattern.Shape.Faces), 6 + 36)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestPolarPattern")
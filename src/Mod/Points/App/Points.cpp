@@ -135,6 +135,11 @@ unsigned int PointKernel::getMemSize () const
     return _Points.size() * sizeof(value_type);
 }
 
+void PointKernel::getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const
+{
+    sizes["Points"] += getMemSize();
+}
+
 PointKernel::size_type PointKernel::countValid() const
 {
     size_type num = 0;
@@ -99,6 +99,7 @@ public:
     //@{
     // Implemented from Persistence
     unsigned int getMemSize () const override;
+    void getMemSizeDetails(std::map<std::string, std::size_t> &sizes) const override;
     void Save (Base::Writer &writer) const override;
     void SaveDocFile (Base::Writer &writer) const override;
     void Restore(Base::XMLReader &reader) override;
@@ -40,22 +40,46 @@ using namespace Points;
 TYPESYSTEM_SOURCE(Points::PropertyPointKernel , App::PropertyComplexGeoData)
 
 PropertyPointKernel::PropertyPointKernel()
-    : _cPoints(new PointKernel())
+    : _cPoints(new PointKernel()), pointsPyObject(nullptr)
 {
 
 }
 
 PropertyPointKernel::~PropertyPointKernel()
 {
+    if (pointsPyObject)
+        Py_DECREF(pointsPyObject);
 }
 
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
-    *_cPoints = m;
+    *detachPointKernel(false) = m;
     hasSetValue();
 }
 
+void PropertyPointKernel::resetPointKernel(PointKernel* points)
+{
+    _cPoints = points;
+    if (pointsPyObject)
+        pointsPyObject->setTwinPointer(points);
+}
+
+PointKernel* PropertyPointKernel::detachPointKernel(bool copyData)
+{
+    if (_cPoints->getRefCount() > 1) {
+        if (copyData) {
+            resetPointKernel(new PointKernel(*_cPoints));
+        }
+        else {
+            PointKernel* points = new PointKernel();
+            points->setTransform(_cPoints->getTransform());
+            resetPointKernel(points);
+        }
+    }
+    return static_cast<PointKernel*>(_cPoints);
+}
+
 const PointKernel& PropertyPointKernel::getValue() const
 {
     return *_cPoints;
@@ -68,7 +92,10 @@ const Data::ComplexGeoData* PropertyPointKernel::getComplexData() const
 
 void PropertyPointKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
-    _cPoints->setTransform(rclTrf);
+    if (_cPoints->getTransform() == rclTrf)
+        return;
+    detachPointKernel()->setTransform(rclTrf);
+    setStatus(Saved, false);
 }
 
 Base::Matrix4D PropertyPointKernel::getTransform() const
@@ -83,9 +110,14 @@ Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 
 PyObject *PropertyPointKernel::getPyObject()
 {
-    PointsPy* points = new PointsPy(&*_cPoints);
-    points->setConst(); // set immutable
-    return points;
+    // Keep the wrapper so that it can follow the point kernel when it gets
+    // replaced by detachPointKernel()
+    if (!pointsPyObject) {
+        pointsPyObject = new PointsPy(&*_cPoints);
+        pointsPyObject->setConst(); // set immutable
+    }
+    Py_INCREF(pointsPyObject);
+    return pointsPyObject;
 }
 
 void PropertyPointKernel::setPyObject(PyObject *value)
@@ -110,7 +142,7 @@ void PropertyPointKernel::Save (Base::Writer &writer) const
 void PropertyPointKernel::Restore(Base::XMLReader &reader)
 {
     aboutToSetValue();
-    _cPoints->Restore(reader);
+    detachPointKernel(false)->Restore(reader);
     hasSetValue();
 }
 
@@ -127,8 +159,9 @@ void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
 
 App::Property *PropertyPointKernel::Copy() const
 {
+    // The copy shares the point kernel until either property is modified
     PropertyPointKernel* prop = new PropertyPointKernel();
-    (*prop->_cPoints) = (*this->_cPoints);
+    prop->_cPoints = this->_cPoints;
     return prop;
 }
 
@@ -136,10 +169,15 @@ void PropertyPointKernel::Paste(const App::Property &from)
 {
     aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    resetPointKernel(static_cast<PointKernel*>(prop._cPoints));
     hasSetValue();
 }
 
+const void *PropertyPointKernel::getSharedData() const
+{
+    return static_cast<const PointKernel*>(_cPoints);
+}
+
 unsigned int PropertyPointKernel::getMemSize () const
 {
     return sizeof(Base::Vector3f) * this->_cPoints->size();
@@ -148,7 +186,7 @@ unsigned int PropertyPointKernel::getMemSize () const
 PointKernel* PropertyPointKernel::startEditing()
 {
     aboutToSetValue();
-    return static_cast<PointKernel*>(_cPoints);
+    return detachPointKernel();
 }
 
 void PropertyPointKernel::finishEditing()
@@ -187,6 +225,6 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
-    _cPoints->transformGeometry(rclMat);
+    detachPointKernel()->transformGeometry(rclMat);
     hasSetValue();
 }
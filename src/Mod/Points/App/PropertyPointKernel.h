@@ -29,6 +29,8 @@
 namespace Points
 {
 
+class PointsPy;
+
 /** The point kernel property
  */
 class PointsExport PropertyPointKernel : public App::PropertyComplexGeoData
@@ -69,6 +71,7 @@ public:
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property &from) override;
     unsigned int getMemSize () const override;
+    const void *getSharedData() const override;
     //@}
 
     /** @name Save/restore */
@@ -88,8 +91,15 @@ public:
     void removeIndices( const std::vector<unsigned long>& );
     //@}
 
+private:
+    /// Replaces the referenced point kernel and updates the Python wrapper
+    void resetPointKernel(PointKernel* points);
+    /// Makes sure the point kernel is not shared with a copy of this property
+    PointKernel* detachPointKernel(bool copyData=true);
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    PointsPy* pointsPyObject;
 };
 
 } // namespace Points
@@ -81,6 +81,8 @@ public:
     short mustExecute() const override;
     /// recalculate the Feature (if no recompute is needed see also solve() and solverNeedsUpdate boolean)
     App::DocumentObjectExecReturn *execute() override;
+    /// The solver notifies the view provider directly on recompute
+    bool canRecomputeInThread() const override {return false;}
 
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override {
@@ -58,6 +58,88 @@ namespace bp = boost::placeholders;
 
 TYPESYSTEM_SOURCE(Spreadsheet::PropertySheet , App::PropertyExpressionContainer)
 
+bool CellStore::chunkIndex(CellAddress address, std::size_t &chunk, int &offset)
+{
+    static const int chunkColumns = (CellAddress::MAX_COLUMNS + ChunkSize - 1) >> ChunkBits;
+
+    int row = address.row();
+    int col = address.col();
+    if (row < 0 || row >= CellAddress::MAX_ROWS || col < 0 || col >= CellAddress::MAX_COLUMNS)
+        return false;
+    chunk = static_cast<std::size_t>((row >> ChunkBits) * chunkColumns + (col >> ChunkBits));
+    offset = ((row & (ChunkSize - 1)) << ChunkBits) | (col & (ChunkSize - 1));
+    return true;
+}
+
+void CellStore::setSlot(CellAddress address, Cell **slot)
+{
+    std::size_t index;
+    int offset;
+    if (!chunkIndex(address, index, offset))
+        return;
+    if (index >= chunks.size()) {
+        if (!slot)
+            return;
+        chunks.resize(index + 1);
+    }
+    auto &chunk = chunks[index];
+    if (!chunk) {
+        if (!slot)
+            return;
+        chunk.reset(new Chunk);
+    }
+    if (!chunk->slots[offset] == !slot) {
+        chunk->slots[offset] = slot;
+        return;
+    }
+    chunk->slots[offset] = slot;
+    if (slot)
+        ++chunk->count;
+    else if (--chunk->count == 0)
+        chunk.reset();
+}
+
+Cell *&CellStore::operator[](CellAddress address)
+{
+    auto res = cells.emplace(address, nullptr);
+    if (res.second)
+        setSlot(address, &res.first->second);
+    return res.first->second;
+}
+
+Cell *CellStore::get(CellAddress address) const
+{
+    std::size_t index;
+    int offset;
+    if (!chunkIndex(address, index, offset)) {
+        auto it = cells.find(address);
+        return it == cells.end() ? nullptr : it->second;
+    }
+    if (index >= chunks.size() || !chunks[index])
+        return nullptr;
+    Cell **slot = chunks[index]->slots[offset];
+    return slot ? *slot : nullptr;
+}
+
+void CellStore::erase(iterator it)
+{
+    setSlot(it->first, nullptr);
+    cells.erase(it);
+}
+
+void CellStore::erase(CellAddress address)
+{
+    auto it = cells.find(address);
+    if (it != cells.end())
+        erase(it);
+}
+
+void CellStore::clear()
+{
+    cells.clear();
+    chunks.clear();
+}
+
 void PropertySheet::clear()
 {
     std::map<CellAddress, Cell* >::iterator i = data.begin();
@@ -78,6 +160,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependantMap.clear();
+    cellToPrecedentMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -86,22 +170,12 @@ void PropertySheet::clear()
 
 Cell *PropertySheet::getValue(CellAddress key)
 {
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(key);
-
-    if (i == data.end())
-        return nullptr;
-    else
-        return i->second;
+    return data.get(key);
 }
 
 const Cell *PropertySheet::getValue(CellAddress key) const
 {
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(key);
-
-    if (i == data.end())
-        return nullptr;
-    else
-        return i->second;
+    return data.get(key);
 }
 
 
@@ -292,6 +366,8 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependantMap(other.cellToDependantMap)
+    , cellToPrecedentMap(other.cellToPrecedentMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -629,12 +705,7 @@ Cell * PropertySheet::cellAt(CellAddress address)
         return i->second;
     }
 
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(address);
-
-    if (i == data.end())
-        return nullptr;
-    else
-        return i->second;
+    return data.get(address);
 }
 
 const Cell * PropertySheet::cellAt(CellAddress address) const
@@ -649,12 +720,7 @@ const Cell * PropertySheet::cellAt(CellAddress address) const
         return i->second;
     }
 
-    std::map<CellAddress, Cell*>::const_iterator i = data.find(address);
-
-    if (i == data.end())
-        return nullptr;
-    else
-        return i->second;
+    return data.get(address);
 }
 
 Cell * PropertySheet::nonNullCellAt(CellAddress address)
@@ -1315,6 +1381,21 @@ void PropertySheet::addDependencies(CellAddress key)
                         cellToPropertyNameMap[key].insert(propName);
                     }
                 }
+
+                // Cell level dependency inside this sheet, used to find the
+                // cells to recompute in Sheet::execute()
+                if (docObj == owner && !name.empty()) {
+                    CellAddress addr = stringToAddress(name.c_str(), true);
+                    if (!addr.isValid()) {
+                        auto j = revAliasProp.find(name);
+                        if (j != revAliasProp.end())
+                            addr = j->second;
+                    }
+                    if (addr.isValid()) {
+                        cellToDependantMap[addr].insert(key);
+                        cellToPrecedentMap[key].insert(addr);
+                    }
+                }
             }
         }
     }
@@ -1349,6 +1430,22 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    /* Remove from cell <-> cell maps */
+
+    auto i3 = cellToPrecedentMap.find(key);
+
+    if (i3 != cellToPrecedentMap.end()) {
+        for (const auto &addr : i3->second) {
+            auto k = cellToDependantMap.find(addr);
+            if (k != cellToDependantMap.end()) {
+                k->second.erase(key);
+                if (k->second.empty())
+                    cellToDependantMap.erase(k);
+            }
+        }
+        cellToPrecedentMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set< std::string > >::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1546,6 +1643,17 @@ const std::set<CellAddress> &PropertySheet::getDeps(const std::string &name) con
         return empty;
 }
 
+const std::set<CellAddress> &PropertySheet::getDependants(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellToDependantMap.find(pos);
+
+    if (i != cellToDependantMap.end())
+        return i->second;
+    else
+        return empty;
+}
+
 const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
 {
     static std::set<std::string> empty;
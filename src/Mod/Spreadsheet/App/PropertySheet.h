@@ -24,6 +24,8 @@
 #define PROPERTYSHEET_H
 
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -38,6 +40,60 @@ class Sheet;
 class PropertySheet;
 class SheetObserver;
 
+/*! Cell storage of PropertySheet
+ *
+ * Cells are owned by an ordered map, which is what saving and the row and
+ * column operations iterate. The address of each map slot is also kept in a
+ * table of fixed size chunks of 32x32 cells, so that looking up a cell by
+ * address does not need to search the map.
+ */
+class SpreadsheetExport CellStore {
+public:
+    typedef std::map<App::CellAddress, Cell*> Map;
+    typedef Map::iterator iterator;
+    typedef Map::const_iterator const_iterator;
+
+    CellStore() = default;
+    CellStore(const CellStore &) = delete;
+    CellStore &operator=(const CellStore &) = delete;
+
+    iterator begin() { return cells.begin(); }
+    iterator end() { return cells.end(); }
+    const_iterator begin() const { return cells.begin(); }
+    const_iterator end() const { return cells.end(); }
+
+    iterator find(App::CellAddress address) { return cells.find(address); }
+    const_iterator find(App::CellAddress address) const { return cells.find(address); }
+
+    std::size_t size() const { return cells.size(); }
+
+    /// Return the slot of \a address, inserting an empty one if not found
+    Cell *&operator[](App::CellAddress address);
+
+    /// Return the cell at \a address, or nullptr if there is none
+    Cell *get(App::CellAddress address) const;
+
+    void erase(iterator it);
+    void erase(App::CellAddress address);
+    void clear();
+
+private:
+    enum {
+        ChunkBits = 5,
+        ChunkSize = 1 << ChunkBits,
+    };
+    struct Chunk {
+        Cell **slots[ChunkSize * ChunkSize] = {};
+        int count = 0;
+    };
+    static bool chunkIndex(App::CellAddress address, std::size_t &chunk, int &offset);
+    void setSlot(App::CellAddress address, Cell **slot);
+
+private:
+    Map cells;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+};
+
 class SpreadsheetExport PropertySheet : public App::PropertyExpressionContainer
                                       , private App::AtomicPropertyChangeInterface<PropertySheet> {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -179,6 +235,9 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    /*! Return the cells of this sheet that directly reference the cell at \a pos */
+    const std::set<App::CellAddress> &getDependants(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject *getPyObject(void) override;
@@ -256,7 +315,7 @@ private:
     std::set<App::CellAddress> dirty;
 
     /*! Cell data in this property */
-    std::map<App::CellAddress, Cell*> data;
+    CellStore data;
 
     /*! Merged cells; cell -> anchor cell */
     std::map<App::CellAddress, App::CellAddress> mergedCells;
@@ -297,6 +356,12 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Cells of this sheet referencing the cell given in key, by address or alias */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToDependantMap;
+
+    /*! Cells of this sheet the cell given in key references */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToPrecedentMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
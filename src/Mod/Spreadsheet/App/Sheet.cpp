@@ -427,6 +427,25 @@ void Sheet::setCell(CellAddress address, const char * value)
     setContent(address, value);
 }
 
+/**
+  * Set the contents of many cells at once. Empty contents clear the cell.
+  * All cells are changed inside one atomic change of the cells property, so
+  * that observers and the undo transaction see a single change.
+  *
+  * @param contents   Pairs of cell address and string value of expression.
+  *
+  */
+
+void Sheet::setCells(const std::vector<std::pair<CellAddress, std::string> > &contents)
+{
+    PropertySheet::AtomicPropertyChange signaller(cells);
+
+    for (const auto &v : contents)
+        setCell(v.first, v.second.c_str());
+
+    signaller.tryInvoke();
+}
+
 /**
   * Get the Python object for the Sheet.
   *
@@ -1060,7 +1079,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
         }
 
         // Process cells that depend on the current cell
-        for(auto &dep : providesTo(currPos)) {
+        for(auto &dep : cells.getDependants(currPos)) {
             auto resDep = VertexList.emplace(dep,Vertex());
             if(resDep.second) {
                 resDep.first->second = add_vertex(graph);
@@ -1119,7 +1138,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
                 }
 
                 // Process cells that depend on the current cell
-                for(auto &dep : providesTo(currPos)) {
+                for(auto &dep : cells.getDependants(currPos)) {
                     auto resDep = VertexList.emplace(dep,Vertex());
                     if(resDep.second) {
                         resDep.first->second = add_vertex(graph);
@@ -1619,7 +1638,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string> & result) cons
 
 std::set<CellAddress>  Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName()+"."+address.toString());
+    return cells.getDependants(address);
 }
 
 void Sheet::onDocumentRestored()
@@ -1130,6 +1130,107 @@ PyObject *SheetPy::getUsedCells(PyObject *args)
     return Py::new_reference_to(pyCellList);
 }
 
+PyObject *SheetPy::importCells(PyObject *args)
+{
+    const char *address;
+    PyObject *rows;
+
+    if (!PyArg_ParseTuple(args, "sO:importCells", &address, &rows))
+        return nullptr;
+
+    PY_TRY {
+        Sheet *sheet = getSheetPtr();
+        std::string cellAddress = sheet->getAddressFromAlias(address);
+        CellAddress start = stringToAddress(cellAddress.empty() ? address : cellAddress.c_str());
+
+        std::vector<std::pair<CellAddress, std::string> > contents;
+        PyObject *rowIter = PyObject_GetIter(rows);
+        if (!rowIter)
+            return nullptr;
+        Py::Object rowIterOwner(rowIter, true);
+
+        int row = start.row();
+        while (PyObject *pyRow = PyIter_Next(rowIter)) {
+            Py::Object rowOwner(pyRow, true);
+            PyObject *colIter = PyObject_GetIter(pyRow);
+            if (!colIter)
+                return nullptr;
+            Py::Object colIterOwner(colIter, true);
+
+            int col = start.col();
+            while (PyObject *item = PyIter_Next(colIter)) {
+                Py::Object itemOwner(item, true);
+                CellAddress cell(row, col++);
+                if (item == Py_None)
+                    continue;
+                if (!cell.isValid()) {
+                    PyErr_Format(PyExc_ValueError, "Cell out of range at row %d, column %d",
+                            cell.row() + 1, cell.col() + 1);
+                    return nullptr;
+                }
+                if (PyUnicode_Check(item))
+                    contents.emplace_back(cell, PyUnicode_AsUTF8(item));
+                else if (PyLong_Check(item) || PyFloat_Check(item)) {
+                    Py::Object str(PyObject_Str(item), true);
+                    contents.emplace_back(cell, PyUnicode_AsUTF8(str.ptr()));
+                }
+                else {
+                    PyErr_Format(PyExc_TypeError, "Expect string, number or None for cell %s, not %s",
+                            cell.toString().c_str(), Py_TYPE(item)->tp_name);
+                    return nullptr;
+                }
+            }
+            if (PyErr_Occurred())
+                return nullptr;
+            ++row;
+        }
+        if (PyErr_Occurred())
+            return nullptr;
+
+        sheet->setCells(contents);
+        Py_Return;
+    } PY_CATCH;
+}
+
+PyObject *SheetPy::exportCells(PyObject *args)
+{
+    const char *strRange;
+    PyObject *values = Py_False;
+
+    if (!PyArg_ParseTuple(args, "s|O!:exportCells", &strRange, &PyBool_Type, &values))
+        return nullptr;
+
+    PY_TRY {
+        Sheet *sheet = getSheetPtr();
+        Range range(strRange, true);
+        bool asValue = PyObject_IsTrue(values);
+
+        Py::List result;
+        for (int row = range.from().row(); row <= range.to().row(); ++row) {
+            Py::List pyRow;
+            for (int col = range.from().col(); col <= range.to().col(); ++col) {
+                CellAddress address(row, col);
+                if (asValue) {
+                    App::Property *prop = sheet->getPropertyByName(address.toString().c_str());
+                    if (prop)
+                        pyRow.append(Py::asObject(prop->getPyObject()));
+                    else
+                        pyRow.append(Py::None());
+                }
+                else {
+                    std::string content;
+                    const Cell *cell = sheet->getCell(address);
+                    if (cell)
+                        cell->getStringContent(content);
+                    pyRow.append(Py::String(content));
+                }
+            }
+            result.append(pyRow);
+        }
+        return Py::new_reference_to(result);
+    } PY_CATCH;
+}
+
 PyObject *SheetPy::getUsedRange(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -1427,6 +1427,81 @@ class SpreadsheetCases(unittest.TestCase):
         sheet.setAlias('A1', 'aliasOfEmptyCell')
         self.assertEqual(sheet.getCellFromAlias("aliasOfEmptyCell"),"A1")
 
+    def testImportExportCells(self):
+        """ Set and get blocks of cells at once """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', 'keep')
+        sheet.set('B2', 'clear me')
+        rows = [[None, 'Name', 'Length'],
+                ('x', '=C2 * 2', 5),
+                ['y', '', 2.5]]
+        sheet.importCells('A1', rows)
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, 'keep')
+        self.assertEqual(sheet.B1, 'Name')
+        self.assertEqual(sheet.C2, 5)
+        self.assertEqual(sheet.C3, 2.5)
+        self.assertEqual(sheet.getContents('B3'), '')
+        self.assertEqual(sheet.exportCells('A1:C3'),
+                         [['keep', 'Name', 'Length'],
+                          ['x', '=C2 * 2', '5'],
+                          ['y', '', '2.5']])
+        values = sheet.exportCells('A2:C3', True)
+        self.assertEqual(values[0][0], 'x')
+        self.assertEqual(values[0][1], 10)
+        self.assertEqual(values[0][2], 5)
+        self.assertIsNone(values[1][1])
+
+        # Rows may come from any iterable, e.g. a csv reader
+        sheet.importCells('D1', ([str(r), '=D%d * 2' % (r + 1)] for r in range(1000)))
+        self.doc.recompute()
+        self.assertEqual(sheet.get('E1000'), 1998)
+        with self.assertRaises(TypeError):
+            sheet.importCells('A1', [[object()]])
+
+    def testIncrementalRecompute(self):
+        """ Recompute cells downstream of a change, including far apart cells """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '1')
+        sheet.setAlias('A1', 'start')
+        for row in range(2, 101):
+            sheet.set('A%d' % row, '=A%d + 1' % (row - 1))
+        sheet.set('B1', '=start * 2')
+        sheet.set('ZZ16000', '=A100 + B1')
+        sheet.set('C1', '=sum(A1:A3)')
+        self.doc.recompute()
+        self.assertEqual(sheet.A100, 100)
+        self.assertEqual(sheet.get('ZZ16000'), 102)
+        self.assertEqual(sheet.C1, 6)
+
+        sheet.set('A1', '10')
+        self.doc.recompute()
+        self.assertEqual(sheet.A100, 109)
+        self.assertEqual(sheet.B1, 20)
+        self.assertEqual(sheet.get('ZZ16000'), 129)
+        self.assertEqual(sheet.C1, 33)
+
+        # Dependencies must follow moved cells
+        sheet.insertRows('2', 1)
+        sheet.set('A1', '20')
+        self.doc.recompute()
+        self.assertEqual(sheet.getContents('A3'), '=A1 + 1')
+        self.assertEqual(sheet.A101, 119)
+        self.assertEqual(sheet.get('ZZ16001'), 159)
+
+        # Removed cells no longer trigger their former dependants
+        sheet.clear('B1')
+        sheet.set('B1', '5')
+        sheet.set('A1', '1')
+        self.doc.recompute()
+        self.assertEqual(sheet.get('ZZ16001'), 105)
+
+        sheet.set('D1', '=D2')
+        sheet.set('D2', '=D1')
+        self.doc.recompute()
+        self.assertIn('Invalid', sheet.State)
+        self.assertEqual(sheet.get('ZZ16001'), 105)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument(self.doc.Name)
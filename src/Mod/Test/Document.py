@@ -50,6 +50,93 @@ class DocumentBasicCases(unittest.TestCase):
     self.assertEqual(self.Doc.getObject(obj.ID), obj)
     self.assertEqual(self.Doc.getObject(obj.ID+1), None)
 
+  def testObjectsOfType(self):
+    TypeId = FreeCAD.Base.TypeId
+    for t in TypeId.getAllDerivedFrom("App::DocumentObject"):
+      parents = []
+      p = t.getParent()
+      while not p.isBad():
+        parents.append(p)
+        p = p.getParent()
+      for p in parents:
+        self.assertTrue(t.isDerivedFrom(p.Name))
+        self.assertFalse(p.isDerivedFrom(t.Name))
+
+    f1 = self.Doc.addObject("App::FeatureTest", "F1")
+    g1 = self.Doc.addObject("App::DocumentObjectGroup", "G1")
+    p1 = self.Doc.addObject("App::FeaturePython", "P1")
+    f2 = self.Doc.addObject("App::FeatureTest", "F2")
+    self.assertEqual(self.Doc.findObjects(Type="App::FeatureTest"), [f1, f2])
+    self.assertEqual(self.Doc.findObjects(Type="App::DocumentObject"), [f1, g1, p1, f2])
+    self.assertEqual(self.Doc.findObjects(Type="App::FeatureTest", Name="F2"), [f2])
+    self.Doc.removeObject(f1.Name)
+    f3 = self.Doc.addObject("App::FeatureTest", "F3")
+    self.assertEqual(self.Doc.findObjects(Type="App::DocumentObject"), [g1, p1, f2, f3])
+    self.Doc.removeObject(g1.Name)
+    self.assertEqual(self.Doc.findObjects(Type="App::DocumentObjectGroup"), [])
+
+  def testObjectsByLabel(self):
+    self.Doc.UndoMode = 1
+    a = self.Doc.addObject("App::FeatureTest", "A")
+    b = self.Doc.addObject("App::FeatureTest", "B")
+    self.assertEqual(self.Doc.getObjectsByLabel("A"), [a])
+
+    self.Doc.openTransaction("Rename")
+    b.Label = "Box"
+    self.Doc.commitTransaction()
+    self.assertEqual(self.Doc.getObjectsByLabel("B"), [])
+    self.assertEqual(self.Doc.getObjectsByLabel("Box"), [b])
+    a.setExpression("Integer", "<<Box>>.Integer + 1")
+    b.Integer = 5
+    self.Doc.recompute()
+    self.assertEqual(a.Integer, 6)
+
+    a.clearExpression("Integer")
+    self.Doc.undo()
+    self.assertEqual(self.Doc.getObjectsByLabel("Box"), [])
+    self.assertEqual(self.Doc.getObjectsByLabel("B"), [b])
+    self.Doc.redo()
+    self.assertEqual(self.Doc.getObjectsByLabel("Box"), [b])
+
+    # relabeling to a used label picks a unique one unless duplicates are allowed
+    c = self.Doc.addObject("App::FeatureTest", "C")
+    c.Label = "Box"
+    self.assertNotEqual(c.Label, "Box")
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    duplicate = param.GetBool("DuplicateLabels", False)
+    param.SetBool("DuplicateLabels", True)
+    try:
+      c.Label = "Box"
+    finally:
+      param.SetBool("DuplicateLabels", duplicate)
+    self.assertEqual(self.Doc.getObjectsByLabel("Box"), [b, c])
+    self.Doc.removeObject(b.Name)
+    self.assertEqual(self.Doc.getObjectsByLabel("Box"), [c])
+
+  def testMemoryReport(self):
+    self.Doc.UndoMode = 1
+    a = self.Doc.addObject("App::FeatureTest", "A")
+    b = self.Doc.addObject("App::FeatureTest", "B")
+    a.VectorList = [(i,i*2,i*3) for i in range(10000)]
+    report = self.Doc.memoryReport()
+    self.assertEqual(report['Total'], sum(report['Categories'].values()))
+    objs = dict((info['Name'], info) for info in report['Objects'])
+    self.assertIn('A', objs)
+    self.assertIn('B', objs)
+    self.assertEqual(report['Objects'][0]['Name'], 'A')
+    self.assertGreaterEqual(objs['A']['Properties']['VectorList'], 10000*24)
+    self.assertEqual(objs['A']['Total'], sum(objs['A']['Categories'].values()))
+    self.assertLess(objs['B']['Total'], objs['A']['Total'])
+
+    # removed objects kept alive by the undo stack are accounted there
+    undo = report['Categories'].get('UndoStack', 0)
+    self.Doc.openTransaction("Remove")
+    self.Doc.removeObject("A")
+    self.Doc.commitTransaction()
+    report = self.Doc.memoryReport()
+    self.assertNotIn('A', [info['Name'] for info in report['Objects']])
+    self.assertGreaterEqual(report['Categories']['UndoStack'], undo + 10000*24)
+
   def testCreateDestroy(self):
     #FIXME: Causes somehow a ref count error but it's _not_ FreeCAD.getDocument()!!!
     #If we remove the whole method no error appears.
@@ -657,6 +744,80 @@ class DocumentSaveRestoreCases(unittest.TestCase):
 
     FreeCAD.closeDocument("SaveRestoreExtensions")
 
+  def testParallelSave(self):
+    import zipfile
+    # large enough to be compressed by the worker threads
+    self.Doc.Label_1.VectorList = [(i,i*2,i*3) for i in range(20000)]
+    self.Doc.Label_2.FloatList = [i*0.5 for i in range(100)]
+    SerialName = self.TempPath + os.sep + "SaveRestoreSerial.FCStd"
+    ParallelName = self.TempPath + os.sep + "SaveRestoreParallel.FCStd"
+
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelSave", False)
+    param.SetBool("ParallelSave", True)
+    try:
+      self.Doc.saveAs(ParallelName)
+    finally:
+      param.SetBool("ParallelSave", parallel)
+    self.Doc.saveAs(SerialName)
+
+    with zipfile.ZipFile(SerialName) as serial, zipfile.ZipFile(ParallelName) as par:
+      self.assertEqual(serial.namelist(), par.namelist())
+      self.assertIsNone(par.testzip())
+      for name in serial.namelist():
+        if name != 'Document.xml':
+          self.assertEqual(serial.read(name), par.read(name))
+
+    Doc = FreeCAD.open(ParallelName)
+    self.assertEqual(len(Doc.Label_1.VectorList), 20000)
+    self.assertEqual(Doc.Label_1.VectorList[-1], FreeCAD.Vector(19999,39998,59997))
+    self.assertEqual(Doc.Label_2.FloatList[-1], 49.5)
+    FreeCAD.closeDocument(Doc.Name)
+
+  def testIncrementalSave(self):
+    Doc = FreeCAD.newDocument("IncrementalSave")
+    Doc.addObject("App::FeatureTest","Label_1").VectorList = [(i,i*2,i*3) for i in range(1000)]
+    Doc.addObject("App::FeatureTest","Label_2").FloatList = [i*0.5 for i in range(100)]
+    FileName = self.TempPath + os.sep + "SaveRestoreIncremental.FCStd"
+
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    incremental = param.GetBool("IncrementalSave", False)
+    backup = param.GetBool("BackupPolicy", True)
+    param.SetBool("IncrementalSave", True)
+    param.SetBool("BackupPolicy", True)
+    try:
+      Doc.saveAs(FileName)
+      self.assertEqual(Doc.ReusedFileCount, 0)
+      # all property files are reused if nothing changed
+      Doc.save()
+      reused = Doc.ReusedFileCount
+      self.assertGreater(reused, 0)
+      # only the changed list is written again
+      Doc.Label_2.FloatList = [i*0.25 for i in range(200)]
+      Doc.save()
+      self.assertEqual(Doc.ReusedFileCount, reused-1)
+      FreeCAD.closeDocument(Doc.Name)
+
+      Doc = FreeCAD.open(FileName)
+      self.assertEqual(len(Doc.Label_1.VectorList), 1000)
+      self.assertEqual(Doc.Label_1.VectorList[-1], FreeCAD.Vector(999,1998,2997))
+      self.assertEqual(Doc.Label_2.FloatList[-1], 49.75)
+
+      # files restored from the archive are reused as well
+      Doc.Label_1.VectorList = [(i,0,0) for i in range(10)]
+      Doc.save()
+      self.assertEqual(Doc.ReusedFileCount, reused-1)
+      FreeCAD.closeDocument(Doc.Name)
+
+      Doc = FreeCAD.open(FileName)
+      self.assertEqual(len(Doc.Label_1.VectorList), 10)
+      self.assertEqual(len(Doc.Label_2.FloatList), 200)
+      self.assertEqual(Doc.Label_2.FloatList[-1], 49.75)
+      FreeCAD.closeDocument(Doc.Name)
+    finally:
+      param.SetBool("IncrementalSave", incremental)
+      param.SetBool("BackupPolicy", backup)
+
   def testPersistenceContentDump(self):
     #test smallest level... property
     self.Doc.Label_1.Vector = (1,2,3)
@@ -814,6 +975,85 @@ class DocumentRecomputeCases(unittest.TestCase):
     res = self.Doc.recompute()
     self.failUnless(res == 5)
 
+  def testDependencyGraphCache(self):
+    self.L1.Link = self.L2
+    self.L2.Link = self.L3
+    self.Doc.recompute()
+    stats = self.Doc.getDependencyGraphStats()
+
+    # only the touched object and its dependents are extracted for recompute
+    self.L2.touch()
+    self.assertEqual(self.Doc.recompute(), 2)
+    stats2 = self.Doc.getDependencyGraphStats()
+    self.assertEqual(stats2['RebuildCount'], stats['RebuildCount'])
+    self.assertEqual(stats2['ReuseCount'], stats['ReuseCount'] + 1)
+    self.assertEqual(stats2['LastSubGraphSize'], 2)
+
+    # link change invalidates the cached graph
+    self.L1.Link = None
+    self.Doc.recompute()
+    stats2 = self.Doc.getDependencyGraphStats()
+    self.assertEqual(stats2['RebuildCount'], stats['RebuildCount'] + 1)
+
+  def testParallelRecompute(self):
+    param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    parallel = param.GetBool("ParallelRecompute", False)
+    param.SetBool("ParallelRecompute", True)
+    try:
+      # independent chains joined at the top
+      top = self.Doc.addObject("App::FeatureTest","Top")
+      chains = []
+      for _ in range(8):
+        base = self.Doc.addObject("App::FeatureTest","Base")
+        mid = self.Doc.addObject("App::FeatureTest","Mid")
+        mid.Link = base
+        chains.append((base, mid))
+      top.LinkList = [mid for _,mid in chains]
+      # object with expression must stay in the main thread
+      chains[0][1].setExpression('Integer', '%s.Integer + 1' % chains[0][0].Name)
+
+      self.Doc.recompute()
+      self.assertEqual(top.ExecCount, 1)
+      for base, mid in chains:
+        self.assertEqual((base.ExecCount, mid.ExecCount), (1, 1))
+
+      # error in one chain must only skip its dependents
+      chains[1][0].ExceptionType = 1
+      chains[2][0].touch()
+      self.Doc.recompute()
+      self.assertFalse(chains[1][0].isValid())
+      self.assertEqual(chains[1][1].ExecCount, 1)
+      self.assertEqual(chains[2][1].ExecCount, 2)
+      self.assertEqual(top.ExecCount, 1)
+    finally:
+      param.SetBool("ParallelRecompute", parallel)
+
+  def testRecomputeProfile(self):
+    import json
+    self.L1.Link = self.L2
+    self.L2.setExpression('Integer', '%s.Integer + 1' % self.L3.Name)
+    TracePath = tempfile.gettempdir() + os.sep + "RecomputeProfile.json"
+    stats = self.Doc.recomputeProfile(None, False, TracePath)
+    self.assertEqual(sorted(s['Object'] for s in stats),
+        sorted(o.FullName for o in (self.L1, self.L2, self.L3)))
+    for s in stats:
+      self.assertEqual(s['Count'], 1)
+      self.assertIn('execute', s['Categories'])
+    self.assertIn('expression', stats[[s['Object'] for s in stats].index(self.L2.FullName)]['Categories'])
+    self.assertEqual([s['WallTime'] for s in stats], sorted((s['WallTime'] for s in stats), reverse=True))
+
+    with open(TracePath) as f:
+      trace = json.load(f)
+    os.remove(TracePath)
+    events = [e for e in trace['traceEvents'] if e['cat'] == 'recompute']
+    self.assertEqual(len(events), 3)
+    self.assertTrue(all(e['ph'] == 'X' and e['dur'] >= 0 for e in events))
+
+    # nothing is recorded outside of recomputeProfile()
+    self.L1.touch()
+    self.Doc.recompute()
+    self.assertEqual(self.Doc.recomputeProfile(), [])
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("RecomputeTests")
@@ -1688,6 +1928,46 @@ class DocumentExpressionCases(unittest.TestCase):
     self.assertEqual(self.Obj3.Float, 4)
     self.assertEqual(self.Obj3.evalExpression(self.Obj3.ExpressionEngine[0][1]), 4)
 
+  def testCompiledExpression(self):
+    src = self.Doc.addObject("App::FeatureTest","Source")
+    src.Integer = 7
+    src.Float = 2.5
+    src.Distance = 3
+    src.Angle = 30
+    obj = self.Doc.addObject("App::FeatureTest","Test")
+    expressions = [
+      ('Float', 'Source.Float * 2 + 3'),
+      ('Float', 'Source.Integer / 2'),
+      ('Float', '-Source.Float ** 2'),
+      ('Float', '2 ^ -1'),
+      ('Float', 'sin(Source.Angle) + sqrt(16)'),
+      ('Integer', 'Source.Integer * 3 - 1'),
+      ('Integer', '2 ** 10'),
+      ('Distance', 'Source.Distance * 2 + 3 mm'),
+      ('Distance', 'hypot(Source.Distance, 4 mm)'),
+      ('Distance', '1 ft 2 in'),
+      # mixed with parts evaluated by Python
+      ('Float', 'Source.Float * [1, 2, 3][1]'),
+      ('Float', 'Source.Placement.Base.x + Source.Integer'),
+      # errors reported by Python
+      ('Distance', 'Source.Distance + 1 s'),
+      ('Float', 'Source.Float / 0'),
+    ]
+    param = FreeCAD.ParamGet('User parameter:BaseApp/Preferences/Document')
+    compiled = param.GetBool('CompileExpressions', True)
+    try:
+      for prop, expr in expressions:
+        results = []
+        for enable in (True, False):
+          param.SetBool('CompileExpressions', enable)
+          obj.setExpression(prop, None)
+          obj.setExpression(prop, expr)
+          self.Doc.recompute()
+          results.append((getattr(obj, prop), obj.State))
+        self.assertEqual(results[0], results[1], expr)
+    finally:
+      param.SetBool('CompileExpressions', compiled)
+
 
   def testIssue4649(self):
       class Cls():
@@ -2307,6 +2587,47 @@ class DocumentObserverCases(unittest.TestCase):
     FreeCAD.Gui.removeDocumentObserver(self.GuiObs)
     self.GuiObs.clear()
 
+  def testChangeBatch(self):
+    self.Doc1 = FreeCAD.newDocument("Observer")
+    obj1 = self.Doc1.addObject("App::FeatureTest","obj1")
+    obj2 = self.Doc1.addObject("App::FeatureTest","obj2")
+    self.Doc1.getChangeNotificationStats(True)
+    self.Obs.clear()
+
+    with FreeCAD.ChangeBatch(self.Doc1):
+      for i in range(100):
+        obj1.Integer = i
+        obj2.Float = i
+      with FreeCAD.ChangeBatch(self.Doc1):
+        obj1.String = 'batched'
+      # nothing is signaled before the outermost batch is closed
+      self.assertNotIn('ObjChanged', self.Obs.signal)
+      self.assertEqual(obj1.Integer, 99)
+
+    self.assertEqual(set(self.Obs.signal), set(['ObjBeforeChange', 'ObjChanged']))
+    changed = [(obj.Name, prop) for sig, obj, prop
+                in zip(self.Obs.signal, self.Obs.parameter, self.Obs.parameter2) if sig == 'ObjChanged']
+    self.assertEqual(changed, [('obj1', 'Integer'), ('obj2', 'Float'), ('obj1', 'String')])
+    stats = self.Doc1.getChangeNotificationStats(True)
+    self.assertEqual(stats['ChangeCount'], 201)
+    self.assertEqual(stats['SignalCount'], 3)
+    self.assertEqual(stats['CoalescedCount'], 198)
+    self.assertEqual(stats['BatchCount'], 1)
+
+    # changes of objects removed inside the batch are dropped
+    self.Obs.clear()
+    with FreeCAD.ChangeBatch(self.Doc1):
+      obj2.Integer = 1
+      self.Doc1.removeObject('obj2')
+    self.assertNotIn('ObjChanged', self.Obs.signal)
+
+    # without batch, every change is signaled
+    self.Obs.clear()
+    obj1.Integer = 1
+    obj1.Integer = 2
+    self.assertEqual(self.Obs.signal.count('ObjChanged'), 2)
+    FreeCAD.closeDocument(self.Doc1.Name)
+
   def tearDown(self):
     #closing doc
     FreeCAD.removeDocumentObserver(self.Obs)
@@ -0,0 +1,80 @@
+"""Benchmark of evaluating property expressions during recompute
+
+A document with many objects bound to each other by arithmetic expressions
+over numbers, units and numeric properties is recomputed with and without
+the compiled evaluation of expressions. The parameter
+'User parameter:BaseApp/Preferences/Document/CompileExpressions' selects
+the evaluation used by the expression engine.
+"""
+
+import time
+
+import FreeCAD
+
+ParamPath = 'User parameter:BaseApp/Preferences/Document'
+
+
+def makeDocument(count):
+    """Returns a document with three expressions per object, i.e. about
+    3 * count expressions in total"""
+    doc = FreeCAD.newDocument('ExpressionBenchmark')
+    previous = None
+    for i in range(count):
+        obj = doc.addObject('App::FeaturePython', 'Param')
+        obj.addProperty('App::PropertyFloat', 'Ratio')
+        obj.addProperty('App::PropertyInteger', 'Count')
+        obj.addProperty('App::PropertyLength', 'Width')
+        if previous is None:
+            obj.Ratio = 1.5
+            obj.Count = 1
+            obj.Width = 10
+        else:
+            name = previous.Name
+            obj.setExpression('Ratio', '%s.Ratio * 1.0001 + 0.5 / %d' % (name, i))
+            obj.setExpression('Count', '%s.Count + %d' % (name, i))
+            obj.setExpression('Width', '%s.Width * 2 / 2 + sin(%s.Ratio) * 1 mm' % (name, name))
+        previous = obj
+    doc.recompute()
+    return doc
+
+
+def benchmarkRecompute(doc, compiled, repeat=3):
+    """Returns the best time in seconds to recompute all objects"""
+    param = FreeCAD.ParamGet(ParamPath)
+    saved = param.GetBool('CompileExpressions', True)
+    param.SetBool('CompileExpressions', compiled)
+    try:
+        best = None
+        for _ in range(repeat):
+            for obj in doc.Objects:
+                obj.touch()
+            start = time.perf_counter()
+            doc.recompute()
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        return best
+    finally:
+        param.SetBool('CompileExpressions', saved)
+
+
+def run(count=3334, repeat=3):
+    """Runs the benchmark and prints the recompute time of both evaluations"""
+    doc = makeDocument(count)
+    try:
+        expressions = sum(len(obj.ExpressionEngine) for obj in doc.Objects)
+        results = {}
+        for compiled in (False, True):
+            results['Compiled' if compiled else 'Python'] = \
+                    benchmarkRecompute(doc, compiled, repeat)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    FreeCAD.Console.PrintMessage('Expression benchmark, %d expressions\n' % expressions)
+    FreeCAD.Console.PrintMessage('%-10s %12s\n' % ('Evaluation', 'Recompute(s)'))
+    for name, elapsed in results.items():
+        FreeCAD.Console.PrintMessage('%-10s %12.4f\n' % (name, elapsed))
+    return results
+
+
+if __name__ == '__main__':
+    run()
@@ -0,0 +1,86 @@
+"""Benchmark of looking up objects by name, label and type in large documents
+
+Synthetic documents with up to 100000 objects are created, and the time of
+looking up objects by name, by label, by type, of relabeling objects and of
+binding expressions that reference objects by label ('<<Label>>') is
+measured. With hashed indices the time per operation stays about the same
+when the document grows.
+"""
+
+import time
+
+import FreeCAD
+
+
+def makeDocument(count):
+    """Returns a document with 'count' objects, every tenth being a group"""
+    doc = FreeCAD.newDocument('LookupBenchmark')
+    for i in range(count):
+        if i % 10 == 0:
+            obj = doc.addObject('App::DocumentObjectGroup', 'Group')
+        else:
+            obj = doc.addObject('App::FeatureTest', 'Feature')
+        obj.Label = 'Part%d' % i
+    return doc
+
+
+def timeIt(func, items):
+    """Returns the time in microseconds per item to call func on the items"""
+    start = time.perf_counter()
+    for item in items:
+        func(item)
+    return (time.perf_counter() - start) * 1e6 / max(1, len(items))
+
+
+def benchmarkDocument(count, samples=1000):
+    """Returns the time in microseconds per operation on a document with
+    'count' objects"""
+    start = time.perf_counter()
+    doc = makeDocument(count)
+    results = {'Create': (time.perf_counter() - start) * 1e6 / count}
+    try:
+        objs = doc.Objects
+        step = max(1, count // samples)
+        sample = objs[::step][:samples]
+        names = [obj.Name for obj in sample]
+        labels = [obj.Label for obj in sample]
+
+        results['Name'] = timeIt(doc.getObject, names)
+        results['Label'] = timeIt(doc.getObjectsByLabel, labels)
+        results['Type'] = timeIt(lambda t: doc.findObjects(Type=t),
+                                 ['App::DocumentObjectGroup'] * 10)
+
+        def relabel(obj):
+            obj.Label = obj.Label + '_renamed'
+        results['Relabel'] = timeIt(relabel, sample)
+
+        features = [obj for obj in sample if obj.isDerivedFrom('App::FeatureTest')]
+        targets = [obj.Label for obj in reversed(features)]
+        def bind(item):
+            obj, label = item
+            obj.setExpression('Integer', '<<%s>>.Integer + 1' % label)
+        results['Bind'] = timeIt(bind, list(zip(features, targets)))
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+    return results
+
+
+def run(counts=(1000, 10000, 100000), samples=1000):
+    """Runs the benchmark and prints the time per operation of each document
+    size"""
+    results = {}
+    for count in counts:
+        results[count] = benchmarkDocument(count, samples)
+
+    columns = ('Create', 'Name', 'Label', 'Type', 'Relabel', 'Bind')
+    FreeCAD.Console.PrintMessage('Lookup benchmark, microseconds per operation\n')
+    FreeCAD.Console.PrintMessage('%-8s' % 'Objects'
+            + ''.join('%10s' % c for c in columns) + '\n')
+    for count, res in results.items():
+        FreeCAD.Console.PrintMessage('%-8d' % count
+                + ''.join('%10.1f' % res[c] for c in columns) + '\n')
+    return results
+
+
+if __name__ == '__main__':
+    run()
@@ -63,6 +63,20 @@ class DocumentSaveRestoreCases(unittest.TestCase):
     FreeCAD.closeDocument("UnicodeTest")
     FreeCAD.newDocument("SaveRestoreTests")
 
+  def testSaveAndRestoreAttribute(self):
+    # characters outside the basic plane and escaped ones in attributes
+    Text = u"\U0001F600 <&\"'> Grüße हिन्दी"
+    self.Doc.Label_1.Label = Text
+    self.Doc.Label_1.String = Text
+    SaveName = self.TempPath + os.sep + "UnicodeAttributeTest.FCStd"
+    self.Doc.saveAs(SaveName)
+    FreeCAD.closeDocument("SaveRestoreTests")
+    self.Doc = FreeCAD.open(SaveName)
+    self.assertEqual(self.Doc.Label_1.Label, Text)
+    self.assertEqual(self.Doc.Label_1.String, Text)
+    FreeCAD.closeDocument("UnicodeAttributeTest")
+    FreeCAD.newDocument("SaveRestoreTests")
+
 
   def tearDown(self):
     #closing doc
@@ -0,0 +1,71 @@
+"""Benchmark of parsing Document.xml with Base::XMLReader
+
+A document with many objects of type App::FeatureTest, which has about
+forty properties of all the basic types, is saved and then opened a few
+times. These objects store almost nothing outside Document.xml, so the
+restore time is dominated by XML parsing.
+"""
+
+import os
+import tempfile
+import time
+import zipfile
+
+import FreeCAD
+
+
+def makeDocument(fileName, count):
+    """Saves a document with the given number of test objects"""
+    doc = FreeCAD.newDocument('XMLReaderBenchmark')
+    try:
+        for i in range(count):
+            obj = doc.addObject('App::FeatureTest', 'Test')
+            obj.Label = 'Test object %d' % i
+            obj.String = 'Some text & <escaped> characters %d' % i
+            obj.Integer = i
+            obj.Float = i * 0.5
+        doc.saveAs(fileName)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def benchmarkRestore(fileName, repeat=3):
+    """Returns the best time in seconds to open the given document"""
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        doc = FreeCAD.openDocument(fileName)
+        elapsed = time.perf_counter() - start
+        FreeCAD.closeDocument(doc.Name)
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def run(counts=(1000, 10000), repeat=3, tempDir=None):
+    """Runs the benchmark and prints the restore time of each document size"""
+    if not tempDir:
+        tempDir = tempfile.gettempdir()
+    results = []
+    for count in counts:
+        fileName = os.path.join(tempDir, 'XMLReaderBenchmark%d.FCStd' % count)
+        makeDocument(fileName, count)
+        with zipfile.ZipFile(fileName) as zf:
+            xmlSize = zf.getinfo('Document.xml').file_size
+        restoreTime = benchmarkRestore(fileName, repeat)
+        results.append({'Objects': count,
+                        'XMLSize': xmlSize,
+                        'RestoreTime': restoreTime,
+                        'FileName': fileName})
+
+    FreeCAD.Console.PrintMessage('Document.xml restore benchmark\n')
+    FreeCAD.Console.PrintMessage('%10s %14s %10s %12s\n'
+            % ('Objects', 'XML bytes', 'Load(s)', 'MB/s'))
+    for res in results:
+        FreeCAD.Console.PrintMessage('%10d %14d %10.4f %12.2f\n'
+                % (res['Objects'], res['XMLSize'], res['RestoreTime'],
+                   res['XMLSize'] / res['RestoreTime'] / 1e6))
+    return results
+
+
+if __name__ == '__main__':
+    run()
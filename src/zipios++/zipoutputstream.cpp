@@ -64,6 +64,13 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
 }
 
 
+void ZipOutputStream::putRawEntry( const ZipCDirEntry &entry, const char *data,
+                                   uint32 size, uint32 uncompressed_size,
+                                   uint32 crc ) {
+  ozf->putRawEntry( entry, data, size, uncompressed_size, crc ) ;
+}
+
+
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
 }
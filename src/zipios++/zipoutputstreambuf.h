@@ -49,6 +49,18 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry whose data has already been deflated by the
+      caller (raw deflate stream without zlib header). Closes the current
+      entry if one is open. The entry is not left open, i.e. the data
+      cannot be appended to afterwards.
+      @param entry the entry to write.
+      @param data the deflated entry data.
+      @param size the size of the deflated data.
+      @param uncompressed_size the size of the data before deflation.
+      @param crc the crc32 of the data before deflation. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, uint32 size,
+                    uint32 uncompressed_size, uint32 crc ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -69,6 +81,8 @@ protected:
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
 
+  static int currentDosTime() ;
+
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
 				     EndOfCentralDirectory eocd,
@@ -0,0 +1,109 @@
+#include <QTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <App/StringHasher.h>
+
+class testStringHasher : public QObject
+{
+    Q_OBJECT
+
+public:
+    testStringHasher()
+    {
+    }
+    ~testStringHasher()
+    {
+    }
+
+    static QByteArray makeText(int i)
+    {
+        return QByteArray("Edge") + QByteArray::number(i);
+    }
+
+private Q_SLOTS:
+    void init()
+    {
+        hasher = new App::StringHasher;
+        hasher->setConcurrent(true);
+    }
+
+    void cleanup()
+    {
+        hasher = App::StringHasherRef();
+    }
+
+    void test_ConcurrentGetID()
+    {
+        const int threadCount = 8;
+        const int textCount = 20000;
+
+        // Each thread walks the same strings in a different order and keeps
+        // the returned IDs so that we can check all threads agree afterwards.
+        std::vector<std::vector<App::StringIDRef>> results(threadCount);
+        std::atomic<bool> start(false);
+        std::atomic<int> mismatch(0);
+        std::vector<std::thread> threads;
+        for (int t=0; t<threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                auto &res = results[t];
+                res.resize(textCount);
+                while (!start)
+                    std::this_thread::yield();
+                for (int n=0; n<textCount; ++n) {
+                    int i = (n * (2*t+1) + t * 997) % textCount;
+                    res[i] = hasher->getID(makeText(i), false, false);
+                    // Mix in lookups by ID of already assigned strings
+                    if (hasher->getID(res[i].value()) != res[i])
+                        ++mismatch;
+                }
+            });
+        }
+        start = true;
+        for (auto &thread : threads)
+            thread.join();
+
+        QCOMPARE(mismatch.load(), 0);
+        QCOMPARE(hasher->size(), static_cast<size_t>(textCount));
+        for (int i=0; i<textCount; ++i) {
+            for (int t=1; t<threadCount; ++t)
+                QVERIFY(results[t][i] == results[0][i]);
+            QCOMPARE(results[0][i].deref().data(), makeText(i));
+        }
+
+        // IDs are assigned without gap in insertion order
+        long expected = 1;
+        for (auto &v : hasher->getIDMap())
+            QCOMPARE(v.first, expected++);
+    }
+
+    void test_ConcurrentRelease()
+    {
+        const int threadCount = 8;
+        const int textCount = 5000;
+        std::vector<std::thread> threads;
+        for (int t=0; t<threadCount; ++t) {
+            threads.emplace_back([&]() {
+                for (int i=0; i<textCount; ++i) {
+                    // Reference is released immediately, only the hasher
+                    // holds on to the string
+                    hasher->getID(makeText(i), false, false);
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        QCOMPARE(hasher->size(), static_cast<size_t>(textCount));
+        QCOMPARE(hasher->count(), static_cast<size_t>(0));
+        hasher->compact();
+        QCOMPARE(hasher->size(), static_cast<size_t>(0));
+    }
+
+private:
+    App::StringHasherRef hasher;
+};
+
+QTEST_GUILESS_MAIN(testStringHasher)
+
+#include "StringHasher.moc"
@@ -0,0 +1,126 @@
+#include <QTest>
+#include <QThreadPool>
+#include <BRep_Tool.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <Mod/Part/Gui/VisualTessellation.h>
+
+using PartGui::VisualData;
+using PartGui::VisualJob;
+
+class testVisualTessellation : public QObject
+{
+    Q_OBJECT
+
+public:
+    testVisualTessellation()
+    {
+    }
+    ~testVisualTessellation()
+    {
+    }
+
+    static TopoDS_Shape makeShape()
+    {
+        // A cylinder has a seam edge with a polygon for each orientation
+        return BRepPrimAPI_MakeCylinder(5.0, 10.0).Shape();
+    }
+
+    static VisualData makeData(const TopoDS_Shape &shape)
+    {
+        VisualData data;
+        data.shape = shape;
+        data.deviation = 0.5;
+        data.angularDeflection = 0.5;
+        return data;
+    }
+
+    static int countTriangulatedFaces(const TopoDS_Shape &shape)
+    {
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        int count = 0;
+        for (int i=1; i<=faces.Extent(); ++i) {
+            TopLoc_Location loc;
+            if (!BRep_Tool::Triangulation(TopoDS::Face(faces(i)), loc).IsNull())
+                ++count;
+        }
+        return count;
+    }
+
+    static void compareData(const VisualData &a, const VisualData &b)
+    {
+        QCOMPARE(a.numTriangles, b.numTriangles);
+        QCOMPARE(a.numNodes, b.numNodes);
+        QCOMPARE(a.numFaces, b.numFaces);
+        QCOMPARE(a.numEdges, b.numEdges);
+        QCOMPARE(a.numLines, b.numLines);
+        QVERIFY(a.verts == b.verts);
+        QVERIFY(a.norms == b.norms);
+        QVERIFY(a.points == b.points);
+        QVERIFY(a.index == b.index);
+        QVERIFY(a.parts == b.parts);
+        QVERIFY(a.lines == b.lines);
+        QVERIFY(a.seams == b.seams);
+    }
+
+    static void waitForJobs()
+    {
+        QThreadPool::globalInstance()->waitForDone();
+        // Deliver the finished notification of the jobs
+        QTest::qWait(50);
+    }
+
+private Q_SLOTS:
+    void test_SameAsSync()
+    {
+#if OCC_VERSION_HEX < 0x070500
+        QSKIP("Background tessellation requires OCCT 7.5");
+#else
+        VisualData sync = makeData(makeShape());
+        QVERIFY(sync.compute());
+        QVERIFY(sync.numTriangles > 0);
+
+        Part::TopoShape shape(makeShape());
+        bool finished = false;
+        auto job = VisualJob::start(shape, makeData(shape.getShape()),
+                                    [&finished](VisualJob &) { finished = true; });
+        QTRY_VERIFY(finished);
+        QVERIFY(job->error.empty());
+        compareData(sync, job->data);
+
+        // The copy is meshed, and the mesh is then attached to the original
+        QCOMPARE(countTriangulatedFaces(shape.getShape()), 0);
+        job->attachTessellation();
+        QCOMPARE(countTriangulatedFaces(shape.getShape()), sync.numFaces);
+
+        // The attached mesh is reused as is
+        VisualData again = makeData(shape.getShape());
+        QVERIFY(again.compute());
+        compareData(sync, again);
+#endif
+    }
+
+    void test_Cancel()
+    {
+#if OCC_VERSION_HEX < 0x070500
+        QSKIP("Background tessellation requires OCCT 7.5");
+#else
+        Part::TopoShape shape(makeShape());
+        bool finished = false;
+        auto job = VisualJob::start(shape, makeData(shape.getShape()),
+                                    [&finished](VisualJob &) { finished = true; });
+        job->canceled = true;
+        waitForJobs();
+        QVERIFY(!finished);
+        QCOMPARE(countTriangulatedFaces(shape.getShape()), 0);
+#endif
+    }
+};
+
+QTEST_GUILESS_MAIN(testVisualTessellation)
+
+#include "VisualTessellation.moc"